@@ -0,0 +1,62 @@
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "request/request_source.h"
+#include "request/trace_format.h"
+
+// Converts between trace formats:
+//   convert_trace binary <input> <output> [n_initial_keys]
+//     reads a TOML (.toml) or CSV trace, CSV ones starting with
+//     n_initial_keys inserted keys
+//   convert_trace toml <input> <output>
+//     reads a binary trace
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0]
+                  << " binary|toml <input> <output> [n_initial_keys]"
+                  << std::endl;
+        return 1;
+    }
+    const auto target_format = std::string(argv[1]);
+    const auto input_path = std::string(argv[2]);
+    const auto output_path = std::string(argv[3]);
+    const auto n_initial_keys = argc > 4 ? std::stoi(argv[4]) : 0;
+
+    auto source = std::unique_ptr<workload::RequestSource>();
+    auto n_variables = n_initial_keys;
+    if (workload::is_binary_trace(input_path)) {
+        auto binary_source = std::make_unique<workload::BinaryTraceRequestSource>(
+            input_path
+        );
+        n_variables = binary_source->header().n_variables;
+        source = std::move(binary_source);
+    } else if (input_path.size() >= 5 and
+               input_path.compare(input_path.size() - 5, 5, ".toml") == 0)
+    {
+        source = std::make_unique<workload::VectorRequestSource>(
+            workload::read_toml_trace(input_path)
+        );
+    } else {
+        source = std::make_unique<workload::FileRequestSource>(
+            input_path, n_initial_keys
+        );
+    }
+
+    std::ofstream output_stream(
+        output_path, std::ofstream::out | std::ofstream::binary
+    );
+    if (target_format == "binary") {
+        workload::write_binary_trace(output_stream, *source, n_variables);
+    } else if (target_format == "toml") {
+        workload::write_toml_trace(
+            output_stream, workload::collect_requests(*source)
+        );
+    } else {
+        std::cerr << "Unknown format " << target_format << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
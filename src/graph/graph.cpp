@@ -2,75 +2,476 @@
 
 namespace model {
 
+VertexView::VertexView(
+    const std::vector<int>& values,
+    const std::vector<bool>& exists,
+    std::size_t size
+) : values_{values},
+    exists_{exists},
+    size_{size}
+{}
+
+VertexView::iterator VertexView::begin() const {
+    return iterator(this, 0);
+}
+
+VertexView::iterator VertexView::end() const {
+    return iterator(this, exists_.size());
+}
+
+std::size_t VertexView::size() const {
+    return size_;
+}
+
+int VertexView::at(int id) const {
+    if (id < 0 or id >= exists_.size() or not exists_[id]) {
+        throw std::out_of_range("vertice " + std::to_string(id));
+    }
+    return values_[id];
+}
+
+VertexView::iterator::iterator(const VertexView* view, int id)
+    : view_{view},
+      id_{id}
+{
+    skip_missing();
+}
+
+void VertexView::iterator::skip_missing() {
+    const auto& exists = view_->exists_;
+    while (id_ < exists.size() and not exists[id_]) {
+        id_++;
+    }
+}
+
+VertexView::iterator::value_type VertexView::iterator::operator*() const {
+    return std::make_pair(id_, view_->values_[id_]);
+}
+
+VertexView::iterator& VertexView::iterator::operator++() {
+    id_++;
+    skip_missing();
+    return *this;
+}
+
+bool VertexView::iterator::operator==(const iterator& other) const {
+    return id_ == other.id_;
+}
+
+bool VertexView::iterator::operator!=(const iterator& other) const {
+    return id_ != other.id_;
+}
+
+EdgeView::EdgeView(const Graph* graph, int vertice)
+    : graph_{graph},
+      vertice_{vertice}
+{}
+
+EdgeView::iterator EdgeView::begin() const {
+    auto csr_index = 0;
+    auto csr_end = 0;
+    if (vertice_ < graph_->row_size_.size()) {
+        csr_index = graph_->row_offset_[vertice_];
+        csr_end = csr_index + graph_->row_size_[vertice_];
+    }
+    return iterator(graph_, csr_index, csr_end, graph_->delta_head_[vertice_]);
+}
+
+EdgeView::iterator EdgeView::end() const {
+    return iterator(graph_, 0, 0, -1);
+}
+
+std::size_t EdgeView::size() const {
+    return graph_->degree_[vertice_];
+}
+
+EdgeView::iterator::iterator(
+    const Graph* graph, int csr_index, int csr_end, int delta_index
+) : graph_{graph},
+    csr_index_{csr_index},
+    csr_end_{csr_end},
+    delta_index_{delta_index}
+{
+    if (csr_index_ == csr_end_) {
+        csr_index_ = csr_end_ = 0;
+    }
+}
+
+EdgeView::iterator::value_type EdgeView::iterator::operator*() const {
+    if (csr_index_ != csr_end_) {
+        return std::make_pair(
+            graph_->neighbours_[csr_index_], graph_->edges_weight_[csr_index_]
+        );
+    }
+    return std::make_pair(
+        graph_->delta_neighbour_[delta_index_],
+        graph_->delta_weight_[delta_index_]
+    );
+}
+
+EdgeView::iterator& EdgeView::iterator::operator++() {
+    if (csr_index_ != csr_end_) {
+        csr_index_++;
+        if (csr_index_ == csr_end_) {
+            csr_index_ = csr_end_ = 0;
+        }
+    } else {
+        delta_index_ = graph_->delta_next_[delta_index_];
+    }
+    return *this;
+}
+
+bool EdgeView::iterator::operator==(const iterator& other) const {
+    return csr_index_ == other.csr_index_ and
+        csr_end_ == other.csr_end_ and
+        delta_index_ == other.delta_index_;
+}
+
+bool EdgeView::iterator::operator!=(const iterator& other) const {
+    return not (*this == other);
+}
+
 Graph::Graph(int n_vertex)
     : n_edges_{0}
 {
     for (auto i = 0; i < n_vertex; i++) {
-        vertex_[i] = 0;
-        edges_[i] = std::unordered_map<int, int>();
-        in_degree_[i] = 0;
+        add_vertice(i);
     }
+    compact();
+}
+
+void Graph::ensure_vertice(int vertice) {
+    if (vertice < exists_.size()) {
+        return;
+    }
+
+    auto size = vertice + 1;
+    compact_ = false;
+    vertex_.resize(size, 0);
+    exists_.resize(size, false);
+    in_degree_.resize(size, 0);
+    delta_head_.resize(size, -1);
+    degree_.resize(size, 0);
 }
 
 void Graph::add_vertice(int id, int weight /*= 0*/) {
+    ensure_vertice(id);
+    if (not exists_[id]) {
+        exists_[id] = true;
+        n_vertex_++;
+    }
+    clear_edges(id);
     vertex_[id] = weight;
     in_degree_[id] = 0;
-    edges_[id] = std::unordered_map<int, int>();
     total_vertex_weight_ += weight;
 }
 
 void Graph::remove_vertice(int vertice_id) {
+    if (not exist_vertice(vertice_id)) {
+        return;
+    }
+
     total_vertex_weight_ -= vertex_[vertice_id];
-    vertex_.erase(vertice_id);
-    edges_.erase(vertice_id);
-    in_degree_.erase(vertice_id);
+    clear_edges(vertice_id);
+    vertex_[vertice_id] = 0;
+    in_degree_[vertice_id] = 0;
+    exists_[vertice_id] = false;
+    n_vertex_--;
+}
+
+void Graph::clear_edges(int vertice) {
+    if (vertice < row_size_.size() and row_size_[vertice] > 0) {
+        row_size_[vertice] = 0;
+        compact_ = false;
+    }
+    delta_head_[vertice] = -1;
+    degree_[vertice] = 0;
+}
+
+int* Graph::find_edge(int from, int to) {
+    const auto* graph = this;
+    return const_cast<int*>(graph->find_edge(from, to));
+}
+
+const int* Graph::find_edge(int from, int to) const {
+    if (from < 0 or from >= exists_.size()) {
+        return nullptr;
+    }
+
+    if (from < row_size_.size()) {
+        auto row_begin = neighbours_.begin() + row_offset_[from];
+        auto row_end = row_begin + row_size_[from];
+        auto it = std::lower_bound(row_begin, row_end, to);
+        if (it != row_end and *it == to) {
+            return &edges_weight_[it - neighbours_.begin()];
+        }
+    }
+
+    for (auto i = delta_head_[from]; i != -1; i = delta_next_[i]) {
+        if (delta_neighbour_[i] == to) {
+            return &delta_weight_[i];
+        }
+    }
+    return nullptr;
+}
+
+void Graph::insert_edge(int from, int to, int weight) {
+    ensure_vertice(from);
+    delta_neighbour_.push_back(to);
+    delta_weight_.push_back(weight);
+    delta_next_.push_back(delta_head_[from]);
+    delta_head_[from] = delta_next_.size() - 1;
+    degree_[from]++;
+    compact_ = false;
+    maybe_compact();
+}
+
+void Graph::maybe_compact() {
+    auto threshold = std::max(
+        MIN_DELTA_SIZE, neighbours_.size() / DELTA_TO_CSR_RATIO
+    );
+    if (delta_next_.size() > threshold) {
+        compact();
+    }
+}
+
+void Graph::compact() {
+    auto n_rows = exists_.size();
+    auto n_entries = 0;
+    for (auto vertice = 0; vertice < n_rows; vertice++) {
+        n_entries += degree_[vertice];
+    }
+
+    auto row_offset = std::vector<int>(n_rows + 1, 0);
+    auto neighbours = std::vector<int>();
+    auto edges_weight = std::vector<int>();
+    neighbours.reserve(n_entries);
+    edges_weight.reserve(n_entries);
+
+    auto delta_row = std::vector<std::pair<int, int>>();
+    for (auto vertice = 0; vertice < n_rows; vertice++) {
+        row_offset[vertice] = neighbours.size();
+
+        delta_row.clear();
+        for (auto i = delta_head_[vertice]; i != -1; i = delta_next_[i]) {
+            delta_row.emplace_back(delta_neighbour_[i], delta_weight_[i]);
+        }
+        std::sort(delta_row.begin(), delta_row.end());
+
+        auto csr_index = 0;
+        auto csr_end = 0;
+        if (vertice < row_size_.size()) {
+            csr_index = row_offset_[vertice];
+            csr_end = csr_index + row_size_[vertice];
+        }
+        auto delta_index = 0;
+        while (csr_index < csr_end or delta_index < delta_row.size()) {
+            auto take_csr = delta_index == delta_row.size() or (
+                csr_index < csr_end and
+                neighbours_[csr_index] < delta_row[delta_index].first
+            );
+            if (take_csr) {
+                neighbours.push_back(neighbours_[csr_index]);
+                edges_weight.push_back(edges_weight_[csr_index]);
+                csr_index++;
+            } else {
+                neighbours.push_back(delta_row[delta_index].first);
+                edges_weight.push_back(delta_row[delta_index].second);
+                delta_index++;
+            }
+        }
+    }
+    row_offset[n_rows] = neighbours.size();
+
+    row_offset_ = std::move(row_offset);
+    row_size_ = degree_;
+    neighbours_ = std::move(neighbours);
+    edges_weight_ = std::move(edges_weight);
+
+    delta_head_.assign(n_rows, -1);
+    std::vector<int>().swap(delta_neighbour_);
+    std::vector<int>().swap(delta_weight_);
+    std::vector<int>().swap(delta_next_);
+    compact_ = true;
+}
+
+bool Graph::is_compact() const {
+    return compact_;
+}
+
+const std::vector<int>& Graph::csr_offsets() const {
+    return row_offset_;
+}
+
+const std::vector<int>& Graph::csr_neighbours() const {
+    return neighbours_;
+}
+
+const std::vector<int>& Graph::csr_weights() const {
+    return edges_weight_;
+}
+
+const std::vector<int>& Graph::vertex_weights() const {
+    return vertex_;
 }
 
 void Graph::add_edge(int from, int to, int weight /*= 0*/) {
-    if (edges_[from].find(to) == edges_[from].end()) {
-        edges_[from][to] = 0;
+    auto* edge_weight = find_edge(from, to);
+    if (edge_weight == nullptr) {
+        insert_edge(from, to, weight);
+    } else {
+        *edge_weight = weight;
     }
 
-    edges_[from][to] = weight;
+    ensure_vertice(to);
     in_degree_[to]++;
     n_edges_++;
     total_edges_weight_ += weight;
 }
 
 void Graph::remove_edge(int from, int to) {
-    if (edges_[from].find(to) != edges_[from].end()) {
-        total_edges_weight_ -= edges_[from][to];
-        edges_[from].erase(to);
-        in_degree_[to]--;
+    if (from < 0 or from >= exists_.size()) {
+        return;
+    }
+
+    if (from < row_size_.size()) {
+        auto row_begin = neighbours_.begin() + row_offset_[from];
+        auto row_end = row_begin + row_size_[from];
+        auto it = std::lower_bound(row_begin, row_end, to);
+        if (it != row_end and *it == to) {
+            auto index = it - neighbours_.begin();
+            total_edges_weight_ -= edges_weight_[index];
+            std::move(it + 1, row_end, it);
+            std::move(
+                edges_weight_.begin() + index + 1,
+                edges_weight_.begin() + (row_end - neighbours_.begin()),
+                edges_weight_.begin() + index
+            );
+            row_size_[from]--;
+            degree_[from]--;
+            compact_ = false;
+            decrease_in_degree(to);
+            return;
+        }
+    }
+
+    auto previous = -1;
+    for (auto i = delta_head_[from]; i != -1; i = delta_next_[i]) {
+        if (delta_neighbour_[i] == to) {
+            total_edges_weight_ -= delta_weight_[i];
+            if (previous == -1) {
+                delta_head_[from] = delta_next_[i];
+            } else {
+                delta_next_[previous] = delta_next_[i];
+            }
+            degree_[from]--;
+            decrease_in_degree(to);
+            return;
+        }
+        previous = i;
+    }
+}
+
+void Graph::decrease_in_degree(int vertice) {
+    if (vertice >= 0 and vertice < in_degree_.size()) {
+        in_degree_[vertice]--;
     }
 }
 
 void Graph::increase_vertice_weight(int vertice, int value /*=1*/) {
+    ensure_vertice(vertice);
+    if (not exists_[vertice]) {
+        exists_[vertice] = true;
+        n_vertex_++;
+    }
     total_vertex_weight_ += value;
     vertex_[vertice] += value;
 }
 
 void Graph::increase_edge_weight(int from, int to, int value /*=1*/) {
-    edges_[from][to] += value;
+    auto* edge_weight = find_edge(from, to);
+    if (edge_weight == nullptr) {
+        insert_edge(from, to, value);
+    } else {
+        *edge_weight += value;
+    }
     total_edges_weight_ += value;
 }
 
+void Graph::decay_vertice(
+    int vertice, int halvings, int min_edge_weight /*= 1*/
+) {
+    if (not exist_vertice(vertice) or halvings <= 0) {
+        return;
+    }
+    halvings = std::min(halvings, 31);
+
+    auto decayed_weight = vertex_[vertice] >> halvings;
+    total_vertex_weight_ -= vertex_[vertice] - decayed_weight;
+    vertex_[vertice] = decayed_weight;
+
+    // returns whether the edge must go
+    auto decay_edge = [&](int neighbour, int& weight) {
+        auto decayed = weight >> halvings;
+        if (decayed < min_edge_weight) {
+            total_edges_weight_ -= weight;
+            degree_[vertice]--;
+            n_edges_--;
+            decrease_in_degree(neighbour);
+            return true;
+        }
+        total_edges_weight_ -= weight - decayed;
+        weight = decayed;
+        return false;
+    };
+
+    if (vertice < row_size_.size()) {
+        auto row_begin = row_offset_[vertice];
+        auto row_end = row_begin + row_size_[vertice];
+        auto kept = row_begin;
+        for (auto i = row_begin; i < row_end; i++) {
+            if (not decay_edge(neighbours_[i], edges_weight_[i])) {
+                neighbours_[kept] = neighbours_[i];
+                edges_weight_[kept] = edges_weight_[i];
+                kept++;
+            }
+        }
+        if (kept != row_end) {
+            row_size_[vertice] = kept - row_begin;
+            compact_ = false;
+        }
+    }
+
+    auto previous = -1;
+    for (auto i = delta_head_[vertice]; i != -1; i = delta_next_[i]) {
+        if (decay_edge(delta_neighbour_[i], delta_weight_[i])) {
+            if (previous == -1) {
+                delta_head_[vertice] = delta_next_[i];
+            } else {
+                delta_next_[previous] = delta_next_[i];
+            }
+        } else {
+            previous = i;
+        }
+    }
+}
+
 void Graph::set_vertice_weight(int vertice, int weight) {
-    total_vertex_weight_ -= vertex_[vertice];
+    total_vertex_weight_ -= vertex_.at(vertice);
     vertex_[vertice] = weight;
-    total_edges_weight_ += weight;
+    total_vertex_weight_ += weight;
 }
 
 bool Graph::exist_vertice(int vertice) const {
-    return vertex_.find(vertice) != vertex_.end();
+    return vertice >= 0 and vertice < exists_.size() and exists_[vertice];
 }
 
 bool Graph::are_connected(int vertice_a, int vertice_b) const {
-    return edges_.at(vertice_a).find(vertice_b) != edges_.at(vertice_a).end();
+    return find_edge(vertice_a, vertice_b) != nullptr;
 }
 
 std::size_t Graph::n_vertex() const {
-    return vertex_.size();
+    return n_vertex_;
 }
 
 std::size_t Graph::n_edges() const {
@@ -78,11 +479,17 @@ std::size_t Graph::n_edges() const {
 }
 
 int Graph::vertice_weight(int vertice) const {
-    return vertex_.at(vertice);
+    return vertex().at(vertice);
 }
 
 int Graph::edge_weight(int from, int to) const {
-    return edges_.at(from).at(to);
+    const auto* weight = find_edge(from, to);
+    if (weight == nullptr) {
+        throw std::out_of_range(
+            "edge " + std::to_string(from) + " " + std::to_string(to)
+        );
+    }
+    return *weight;
 }
 
 int Graph::total_vertex_weight() const {
@@ -93,20 +500,23 @@ int Graph::total_edges_weight() const {
     return total_edges_weight_;
 }
 
-const std::unordered_map<int, int>& Graph::vertice_edges(int vertice) const {
-    return edges_.at(vertice);
+EdgeView Graph::vertice_edges(int vertice) const {
+    if (not exist_vertice(vertice)) {
+        throw std::out_of_range("vertice " + std::to_string(vertice));
+    }
+    return EdgeView(this, vertice);
 }
 
-const Vertex& Graph::vertex() const {
-    return vertex_;
+VertexView Graph::vertex() const {
+    return VertexView(vertex_, exists_, n_vertex_);
 }
 
 int Graph::in_degree(int vertice) const {
-    return in_degree_.at(vertice);
+    return in_degrees().at(vertice);
 }
 
-const std::unordered_map<int, int>& Graph::in_degrees() const {
-    return in_degree_;
+VertexView Graph::in_degrees() const {
+    return VertexView(in_degree_, exists_, n_vertex_);
 }
 
 }
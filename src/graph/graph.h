@@ -1,17 +1,108 @@
 #ifndef MODEL_GRAPH_H
 #define MODEL_GRAPH_H
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 // bad name, idk to what to change
 namespace model {
 
-typedef std::unordered_map<int, int> Vertex;
-typedef std::unordered_map<int,std::unordered_map<int, int>> Edges;
+// The delta buffer is merged into the CSR rows once it holds more than
+// max(MIN_DELTA_SIZE, n_csr_edges / DELTA_TO_CSR_RATIO) entries
+const std::size_t MIN_DELTA_SIZE = 4096;
+const std::size_t DELTA_TO_CSR_RATIO = 8;
 
+class Graph;
+
+// Read-only range over the (id, value) pairs of the existing vertex,
+// ordered by id.
+class VertexView {
+public:
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::pair<int, int> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+        iterator(const VertexView* view, int id);
+
+        value_type operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+
+    private:
+        void skip_missing();
+
+        const VertexView* view_;
+        int id_;
+    };
+
+    VertexView(
+        const std::vector<int>& values,
+        const std::vector<bool>& exists,
+        std::size_t size
+    );
+
+    iterator begin() const;
+    iterator end() const;
+    std::size_t size() const;
+    int at(int id) const;
+
+private:
+    const std::vector<int>& values_;
+    const std::vector<bool>& exists_;
+    std::size_t size_;
+};
+
+// Read-only range over the (neighbour, weight) pairs of one vertex. Edges
+// already compacted come first, sorted by neighbour, followed by the ones
+// still waiting in the delta buffer.
+class EdgeView {
+public:
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::pair<int, int> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+        iterator(const Graph* graph, int csr_index, int csr_end, int delta_index);
+
+        value_type operator*() const;
+        iterator& operator++();
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+
+    private:
+        const Graph* graph_;
+        int csr_index_, csr_end_, delta_index_;
+    };
+
+    EdgeView(const Graph* graph, int vertice);
+
+    iterator begin() const;
+    iterator end() const;
+    std::size_t size() const;
+
+private:
+    const Graph* graph_;
+    int vertice_;
+};
+
+// Vertex ids index dense arrays, so they are expected to be (mostly)
+// contiguous from zero. Out edges are kept in a compressed sparse row
+// structure; new edges go to a small linked delta buffer that is merged
+// into the rows once it grows past a fraction of the CSR size.
 class Graph {
 public:
     Graph() = default;
@@ -24,6 +115,9 @@ public:
     void increase_vertice_weight(int vertice, int value = 1);
     void set_vertice_weight(int vertice, int weight);
     void increase_edge_weight(int from, int to, int value = 1);
+    // Halves the weight of a vertice and of its out edges `halvings`
+    // times, removing the edges left lighter than min_edge_weight
+    void decay_vertice(int vertice, int halvings, int min_edge_weight = 1);
 
     bool exist_vertice(int vertice) const;
     bool are_connected(int vertice_a, int vertice_b) const;
@@ -33,18 +127,56 @@ public:
     int total_edges_weight() const;
     int vertice_weight(int vertice) const;
     int edge_weight(int from, int to) const;
-    const std::unordered_map<int, int>& vertice_edges(int vertice) const;
-    const Vertex& vertex() const;
+    EdgeView vertice_edges(int vertice) const;
+    VertexView vertex() const;
     int in_degree(int vertice) const;
-    const std::unordered_map<int, int>& in_degrees() const;
+    VertexView in_degrees() const;
+
+    // Once compacted (and until the next structural change) the rows below
+    // are exactly the xadj/adjncy/adjwgt/vwgt arrays METIS and KaHIP take,
+    // with one row per id in [0, csr_offsets().size() - 1)
+    void compact();
+    bool is_compact() const;
+    const std::vector<int>& csr_offsets() const;
+    const std::vector<int>& csr_neighbours() const;
+    const std::vector<int>& csr_weights() const;
+    const std::vector<int>& vertex_weights() const;
+
+private:
+    friend class EdgeView;
+
+    void ensure_vertice(int vertice);
+    void clear_edges(int vertice);
+    int* find_edge(int from, int to);
+    const int* find_edge(int from, int to) const;
+    void insert_edge(int from, int to, int weight);
+    void decrease_in_degree(int vertice);
+    void maybe_compact();
+
+    std::vector<int> vertex_;
+    std::vector<bool> exists_;
+    std::vector<int> in_degree_;
+    std::size_t n_vertex_{0};
+
+    // CSR rows, one per vertex known at the last compaction. row_size_
+    // holds how many entries of the row are still alive, as removed
+    // edges are shifted out of it.
+    std::vector<int> row_offset_{0};
+    std::vector<int> row_size_;
+    std::vector<int> neighbours_;
+    std::vector<int> edges_weight_;
+
+    // Delta buffer: per vertex singly linked lists over shared arrays
+    std::vector<int> delta_head_;
+    std::vector<int> delta_neighbour_;
+    std::vector<int> delta_weight_;
+    std::vector<int> delta_next_;
 
-protected:
-    Vertex vertex_;
-    Edges edges_;
+    std::vector<int> degree_;
+    bool compact_{true};
     int n_edges_{0};
     int total_edges_weight_{0};
     int total_vertex_weight_{0};
-    std::unordered_map<int, int> in_degree_;
 };
 
 }
@@ -0,0 +1,205 @@
+#include "hypergraph.h"
+
+namespace model {
+
+PinView::PinView(const int* begin, const int* end)
+    : begin_{begin},
+      end_{end}
+{}
+
+const int* PinView::begin() const {
+    return begin_;
+}
+
+const int* PinView::end() const {
+    return end_;
+}
+
+std::size_t PinView::size() const {
+    return end_ - begin_;
+}
+
+Hypergraph::Hypergraph(int n_vertex) {
+    for (auto i = 0; i < n_vertex; i++) {
+        add_vertice(i);
+    }
+}
+
+void Hypergraph::ensure_vertice(int vertice) {
+    if (vertice >= exists_.size()) {
+        vertex_.resize(vertice + 1, 0);
+        exists_.resize(vertice + 1, false);
+    }
+    if (not exists_[vertice]) {
+        exists_[vertice] = true;
+        n_vertex_++;
+    }
+}
+
+void Hypergraph::add_vertice(int id, int weight /*= 0*/) {
+    ensure_vertice(id);
+    total_vertex_weight_ += weight - vertex_[id];
+    vertex_[id] = weight;
+}
+
+void Hypergraph::increase_vertice_weight(int vertice, int value /*= 1*/) {
+    ensure_vertice(vertice);
+    vertex_[vertice] += value;
+    total_vertex_weight_ += value;
+}
+
+// Nets with less than two pins can't be cut, so they are not stored and
+// -1 is returned
+int Hypergraph::add_net(std::vector<int> pins, int weight /*= 1*/) {
+    std::sort(pins.begin(), pins.end());
+    pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+    for (auto pin : pins) {
+        ensure_vertice(pin);
+    }
+    if (pins.size() < 2) {
+        return -1;
+    }
+
+    // FNV-1a over the sorted pins
+    std::uint64_t hash = 14695981039346656037ull;
+    for (auto pin : pins) {
+        hash ^= static_cast<std::uint32_t>(pin);
+        hash *= 1099511628211ull;
+    }
+
+    total_nets_weight_ += weight;
+    auto net = find_net(pins, hash);
+    if (net != -1) {
+        net_weight_[net] += weight;
+        return net;
+    }
+
+    net = net_weight_.size();
+    pins_.insert(pins_.end(), pins.begin(), pins.end());
+    net_offset_.push_back(pins_.size());
+    net_weight_.push_back(weight);
+    net_index_.emplace(hash, net);
+    return net;
+}
+
+int Hypergraph::find_net(const std::vector<int>& pins, std::uint64_t hash) const {
+    auto candidates = net_index_.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; it++) {
+        auto net = it->second;
+        auto net_pins = this->net_pins(net);
+        if (net_pins.size() == pins.size() and
+            std::equal(pins.begin(), pins.end(), net_pins.begin()))
+        {
+            return net;
+        }
+    }
+    return -1;
+}
+
+bool Hypergraph::exist_vertice(int vertice) const {
+    return vertice >= 0 and vertice < exists_.size() and exists_[vertice];
+}
+
+std::size_t Hypergraph::n_vertex() const {
+    return n_vertex_;
+}
+
+std::size_t Hypergraph::n_nets() const {
+    return net_weight_.size();
+}
+
+std::size_t Hypergraph::n_pins() const {
+    return pins_.size();
+}
+
+int Hypergraph::total_vertex_weight() const {
+    return total_vertex_weight_;
+}
+
+int Hypergraph::total_nets_weight() const {
+    return total_nets_weight_;
+}
+
+int Hypergraph::vertice_weight(int vertice) const {
+    return vertex().at(vertice);
+}
+
+int Hypergraph::net_weight(int net) const {
+    return net_weight_.at(net);
+}
+
+PinView Hypergraph::net_pins(int net) const {
+    return PinView(
+        pins_.data() + net_offset_[net], pins_.data() + net_offset_[net + 1]
+    );
+}
+
+VertexView Hypergraph::vertex() const {
+    return VertexView(vertex_, exists_, n_vertex_);
+}
+
+void Hypergraph::incident_nets(
+    std::vector<int>& offsets, std::vector<int>& nets
+) const {
+    offsets.assign(exists_.size() + 1, 0);
+    for (auto pin : pins_) {
+        offsets[pin + 1]++;
+    }
+    for (auto i = 0; i < exists_.size(); i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    nets.resize(pins_.size());
+    auto next = std::vector<int>(offsets.begin(), offsets.end() - 1);
+    for (auto net = 0; net < n_nets(); net++) {
+        for (auto pin : net_pins(net)) {
+            nets[next[pin]++] = net;
+        }
+    }
+}
+
+long long Hypergraph::connectivity_cost(
+    const std::vector<int>& vertice_partition, int n_partitions
+) const {
+    auto last_net_in_partition = std::vector<int>(n_partitions, -1);
+    auto cost = 0ll;
+    for (auto net = 0; net < n_nets(); net++) {
+        auto connectivity = 0;
+        for (auto pin : net_pins(net)) {
+            auto partition = vertice_partition[pin];
+            if (last_net_in_partition[partition] != net) {
+                last_net_in_partition[partition] = net;
+                connectivity++;
+            }
+        }
+        cost += (long long) net_weight_[net] * (connectivity - 1);
+    }
+    return cost;
+}
+
+Graph Hypergraph::clique_projection() const {
+    auto graph = Graph();
+    for (const auto& kv : vertex()) {
+        graph.add_vertice(kv.first, kv.second);
+    }
+
+    for (auto net = 0; net < n_nets(); net++) {
+        auto weight = net_weight_[net];
+        auto pins = net_pins(net);
+        for (auto u = pins.begin(); u != pins.end(); u++) {
+            for (auto v = u + 1; v != pins.end(); v++) {
+                if (not graph.are_connected(*u, *v)) {
+                    graph.add_edge(*u, *v);
+                    graph.add_edge(*v, *u);
+                }
+                graph.increase_edge_weight(*u, *v, weight);
+                graph.increase_edge_weight(*v, *u, weight);
+            }
+        }
+    }
+
+    graph.compact();
+    return graph;
+}
+
+}
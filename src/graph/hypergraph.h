@@ -0,0 +1,87 @@
+#ifndef MODEL_HYPERGRAPH_H
+#define MODEL_HYPERGRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+
+namespace model {
+
+// How jointly accessed values are recorded: CLIQUE adds an edge between
+// every pair of values of a request, HYPERGRAPH stores the request key-set
+// once as a net
+enum AccessModel {CLIQUE, HYPERGRAPH};
+const std::unordered_map<std::string, AccessModel> string_to_access_model({
+    {"CLIQUE", CLIQUE},
+    {"HYPERGRAPH", HYPERGRAPH}
+});
+
+class PinView {
+public:
+    PinView(const int* begin, const int* end);
+
+    const int* begin() const;
+    const int* end() const;
+    std::size_t size() const;
+
+private:
+    const int* begin_;
+    const int* end_;
+};
+
+// Every distinct key-set is a net stored once, with a weight counting how
+// many times it was accessed. Like Graph, vertex ids index dense arrays.
+class Hypergraph {
+public:
+    Hypergraph() = default;
+    Hypergraph(int n_vertex);
+
+    void add_vertice(int id, int weight = 0);
+    void increase_vertice_weight(int vertice, int value = 1);
+    int add_net(std::vector<int> pins, int weight = 1);
+
+    bool exist_vertice(int vertice) const;
+    std::size_t n_vertex() const;
+    std::size_t n_nets() const;
+    std::size_t n_pins() const;
+    int total_vertex_weight() const;
+    int total_nets_weight() const;
+    int vertice_weight(int vertice) const;
+    int net_weight(int net) const;
+    PinView net_pins(int net) const;
+    VertexView vertex() const;
+
+    // Nets incident to each vertex, as CSR rows indexed by vertex id
+    void incident_nets(
+        std::vector<int>& offsets, std::vector<int>& nets
+    ) const;
+    // Sum over nets of weight * (partitions spanned - 1)
+    long long connectivity_cost(
+        const std::vector<int>& vertice_partition, int n_partitions
+    ) const;
+    Graph clique_projection() const;
+
+private:
+    void ensure_vertice(int vertice);
+    int find_net(const std::vector<int>& pins, std::uint64_t hash) const;
+
+    std::vector<int> vertex_;
+    std::vector<bool> exists_;
+    std::size_t n_vertex_{0};
+    int total_vertex_weight_{0};
+
+    std::vector<int> net_offset_{0};
+    std::vector<int> pins_;
+    std::vector<int> net_weight_;
+    int total_nets_weight_{0};
+    std::unordered_multimap<std::uint64_t, int> net_index_;
+};
+
+}
+
+#endif
@@ -3,124 +3,210 @@
 namespace model {
 
 SpanningTree::SpanningTree(int n_ids)
-    : Graph{n_ids}
-{
-    for (auto i = 0; i < n_ids; i++) {
-        detatched_ids_.insert(i);
+    : vertex_weight_(n_ids, 0),
+      id_to_node_(n_ids, -1),
+      next_id_(n_ids, -1),
+      parent_(n_ids, -1),
+      depth_(n_ids, 0),
+      jump_(n_ids, -1),
+      root_(n_ids, -1),
+      first_id_(n_ids, -1),
+      node_increment_(n_ids, 0),
+      edge_increment_(n_ids, 0),
+      subtree_node_weight_(n_ids, 0),
+      subtree_edge_weight_(n_ids, 0)
+{}
+
+// Ids past the ones given on construction grow every per-id array
+void SpanningTree::reserve_id(int id) {
+    if (id < 0) {
+        throw std::out_of_range("id " + std::to_string(id));
     }
+    if (id < vertex_weight_.size()) {
+        return;
+    }
+    auto n_ids = id + 1;
+    vertex_weight_.resize(n_ids, 0);
+    id_to_node_.resize(n_ids, -1);
+    next_id_.resize(n_ids, -1);
+    parent_.resize(n_ids, -1);
+    depth_.resize(n_ids, 0);
+    jump_.resize(n_ids, -1);
+    root_.resize(n_ids, -1);
+    first_id_.resize(n_ids, -1);
+    node_increment_.resize(n_ids, 0);
+    edge_increment_.resize(n_ids, 0);
+    subtree_node_weight_.resize(n_ids, 0);
+    subtree_edge_weight_.resize(n_ids, 0);
 }
 
 void SpanningTree::increase_node_weight(int node, int value /*=1*/) {
-    if (detatched_ids_.find(node) != detatched_ids_.end()) {
-        Graph::increase_vertice_weight(node, value);
+    reserve_id(node);
+    if (is_detatched(node)) {
+        increase_vertice_weight(node, value);
     } else {
         auto current_node = id_to_node_[node];
-        while (current_node != -1) {
-            Graph::increase_vertice_weight(current_node, value);
-            current_node = parent_node_[current_node];
-        }
+        node_increment_[current_node] += value;
+        total_vertex_weight_ += value * depth_[current_node];
+        settled_ = false;
     }
 }
 
 void SpanningTree::increase_edge_weight(Edge edge, int value) {
+    reserve_id(edge.first);
+    reserve_id(edge.second);
     auto u_id = id_to_node_[edge.first];
     auto v_id = id_to_node_[edge.second];
 
-    while (node_depth_[u_id] > node_depth_[v_id]) {
-        auto parent = parent_node_[u_id];
-        Graph::increase_edge_weight(u_id, parent, value);
-        u_id = parent_node_[u_id];
-    }
-    while (node_depth_[u_id] < node_depth_[v_id]) {
-        auto parent = parent_node_[v_id];
-        Graph::increase_edge_weight(v_id, parent, value);
-        v_id = parent_node_[v_id];
+    edge_increment_[u_id] += value;
+    edge_increment_[v_id] += value;
+    if (root_[u_id] == root_[v_id]) {
+        edge_increment_[lowest_common_ancestor(u_id, v_id)] -= 2 * value;
     }
+    settled_ = false;
+}
 
-    while (v_id != u_id) {
-        auto u_parent = parent_node_[u_id];
-        Graph::increase_edge_weight(u_id, u_parent, value);
-        u_id = parent_node_[u_id];
+// Jump pointers as in Myers' skew-binary scheme: their depths only depend
+// on the depth of the node, so two nodes at the same depth can follow
+// them together
+void SpanningTree::add_node(int node, int parent) {
+    parent_[node] = parent;
+    if (parent == -1) {
+        depth_[node] = 1;
+        jump_[node] = node;
+        root_[node] = node;
+    } else {
+        depth_[node] = depth_[parent] + 1;
+        root_[node] = root_[parent];
+        auto jump = jump_[parent];
+        if (depth_[parent] - depth_[jump] == depth_[jump] - depth_[jump_[jump]]) {
+            jump_[node] = jump_[jump];
+        } else {
+            jump_[node] = parent;
+        }
+    }
+    nodes_.push_back(node);
+}
 
-        auto v_parent = parent_node_[v_id];
-        Graph::increase_edge_weight(v_id, v_parent, value);
-        v_id = parent_node_[v_id];
+int SpanningTree::lowest_common_ancestor(int u, int v) const {
+    while (depth_[u] > depth_[v]) {
+        u = depth_[jump_[u]] >= depth_[v] ? jump_[u] : parent_[u];
+    }
+    while (depth_[v] > depth_[u]) {
+        v = depth_[jump_[v]] >= depth_[u] ? jump_[v] : parent_[v];
+    }
+    while (u != v) {
+        if (jump_[u] != jump_[v]) {
+            u = jump_[u];
+            v = jump_[v];
+        } else {
+            u = parent_[u];
+            v = parent_[v];
+        }
     }
+    return u;
 }
 
-void SpanningTree::add_vertice_with_neighbour(int new_id, int existing_node) {
-    if (parent_node_.find(existing_node) == parent_node_.end()) {
-        auto parent = id_to_node_[existing_node];
-        auto parent_depth = node_depth_[parent];
+void SpanningTree::attach(int id, int node) {
+    id_to_node_[id] = node;
+    next_id_[id] = first_id_[node];
+    first_id_[node] = id;
+}
 
-        parent_node_[existing_node] = parent;
-        node_depth_[existing_node] = parent_depth + 1;
+void SpanningTree::add_vertice_with_neighbour(int new_id, int existing_id) {
+    if (depth_[existing_id] == 0) {
+        add_node(existing_id, id_to_node_[existing_id]);
     }
-    id_to_node_[new_id] = existing_node;
-    ids_in_nodes_[existing_node].insert(new_id);
-    increase_node_weight(existing_node, vertice_weight(new_id));
+    attach(new_id, existing_id);
+    increase_node_weight(existing_id, vertex_weight_[new_id]);
 }
 
 void SpanningTree::add_edge(Edge edge, int weight /*= 1*/) {
     auto u = edge.first;
     auto v = edge.second;
-    if (id_to_node_.find(u) == id_to_node_.end() and
-        id_to_node_.find(v) == id_to_node_.end()
-    ) {
-        parent_node_[u] = -1;
-        node_depth_[u] = 1;
-
-        id_to_node_[u] = u;
-        id_to_node_[v] = u;
-        ids_in_nodes_[u].insert(u);
-        ids_in_nodes_[u].insert(v);
-        auto node_weight = vertice_weight(u) + vertice_weight(v);
+    reserve_id(u);
+    reserve_id(v);
+    if (is_detatched(u) and is_detatched(v)) {
+        add_node(u, -1);
+        attach(u, u);
+        attach(v, u);
+        auto node_weight = vertex_weight_[u] + vertex_weight_[v];
         increase_node_weight(u, node_weight);
     } else {
-        if (id_to_node_.find(u) == id_to_node_.end()) {
+        if (is_detatched(u)) {
             add_vertice_with_neighbour(u, v);
-        } else if (id_to_node_.find(v) == id_to_node_.end()) {
+        } else if (is_detatched(v)) {
             add_vertice_with_neighbour(v, u);
         }
-        
+
         increase_edge_weight(edge, weight);
     }
-    
-    detatched_ids_.erase(v);
-    detatched_ids_.erase(u);
 }
 
-void SpanningTree::unpropagate_weight(int node) {
-    auto weight = vertex_[node];
-    auto current_node = id_to_node_[node];
-    while (current_node != -1) {
-        increase_vertice_weight(node, -weight);
-        current_node = parent_node_[current_node];
+void SpanningTree::increase_vertice_weight(int id, int value) {
+    vertex_weight_[id] += value;
+    total_vertex_weight_ += value;
+}
+
+void SpanningTree::settle() const {
+    if (settled_) {
+        return;
+    }
+
+    subtree_node_weight_ = node_increment_;
+    subtree_edge_weight_ = edge_increment_;
+    for (auto i = nodes_.size(); i-- > 0;) {
+        auto node = nodes_[i];
+        auto parent = parent_[node];
+        if (parent != -1) {
+            subtree_node_weight_[parent] += subtree_node_weight_[node];
+            subtree_edge_weight_[parent] += subtree_edge_weight_[node];
+        }
     }
+    settled_ = true;
 }
 
-const std::unordered_map<int, int>& SpanningTree::id_to_node() const {
-    return id_to_node_;
+int SpanningTree::n_ids() const {
+    return vertex_weight_.size();
 }
 
-const std::unordered_map<int, std::unordered_set<int>>& SpanningTree::ids_in_nodes() const {
-    return ids_in_nodes_;
+int SpanningTree::total_vertex_weight() const {
+    return total_vertex_weight_;
 }
 
-const std::unordered_set<int>& SpanningTree::ids_in_node(int node) const {
-    return ids_in_nodes_.at(node);
+int SpanningTree::vertice_weight(int id) const {
+    if (is_inside_node(id)) {
+        return vertex_weight_.at(id);
+    }
+    settle();
+    return vertex_weight_[id] + subtree_node_weight_[id];
+}
+
+int SpanningTree::parent_edge_weight(int node) const {
+    if (is_inside_node(node)) {
+        throw std::out_of_range("node " + std::to_string(node));
+    }
+    settle();
+    return subtree_edge_weight_[node];
+}
+
+const std::vector<int>& SpanningTree::nodes() const {
+    return nodes_;
 }
 
 bool SpanningTree::is_detatched(int id) const {
-    return detatched_ids_.find(id) != detatched_ids_.end();
+    return id >= 0 and (id >= id_to_node_.size() or id_to_node_[id] == -1);
 }
 
 bool SpanningTree::is_inside_node(int id) const {
-    return parent_node_.find(id) == parent_node_.end();
-};
+    return id < 0 or id >= depth_.size() or depth_[id] == 0;
+}
 
 int SpanningTree::parent(int node) const {
-    return parent_node_.at(node);
+    if (is_inside_node(node)) {
+        throw std::out_of_range("node " + std::to_string(node));
+    }
+    return parent_[node];
 }
 
-}
\ No newline at end of file
+}
@@ -1,18 +1,28 @@
 #ifndef MODEL_SPANNING_TREE_H
 #define MODEL_SPANNING_TREE_H
 
-#include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <stdexcept>
+#include <string>
 #include <utility>
-
-#include "graph.h"
+#include <vector>
 
 namespace model {
 
 typedef std::pair<int, int> Edge;
 
-class SpanningTree : public Graph {
+// Forest of supernodes over ids in [0, n_ids), n_ids growing with the
+// largest id seen. A supernode is named after
+// an id and groups the ids attached to it; detached ids belong to none.
+//
+// Node and edge weights are path sums: accessing an id adds to the weight
+// of every node from its node up to the root, and accessing a pair adds to
+// every edge on the path between their nodes. Both are kept as point
+// increments (at the start of the path and, for edges, minus twice at the
+// lowest common ancestor) and resolved into subtree sums on the first read
+// after a change. Nodes are only ever added as leaves, so lowest common
+// ancestors are found through jump pointers in O(log depth) and per-access
+// cost doesn't depend on the tree depth.
+class SpanningTree {
 public:
     SpanningTree() = default;
     SpanningTree(int n_ids);
@@ -20,24 +30,57 @@ public:
     void add_edge(Edge edge, int weight = 1);
     void increase_node_weight(int node, int value);
     void increase_edge_weight(Edge edge, int value);
-    void unpropagate_weight(int node);
-    void print_stuff();
 
+    int n_ids() const;
+    int total_vertex_weight() const;
+    int vertice_weight(int id) const;
+    // Weight of the edge between a node and its parent. Paths between
+    // different trees cross the root edges.
+    int parent_edge_weight(int node) const;
     int parent(int node) const;
     bool is_detatched(int id) const;
     bool is_inside_node(int id) const;
-    const std::unordered_map<int, int>& id_to_node() const;
-    const std::unordered_map<int, std::unordered_set<int>>& ids_in_nodes() const;
-    const std::unordered_set<int>& ids_in_node(int node) const;
+    // Nodes in creation order, so parents come before their children
+    const std::vector<int>& nodes() const;
+
+    // Calls function(id) for every id attached to the node
+    template<typename Function>
+    void for_each_id_in_node(int node, Function function) const {
+        for (auto id = first_id_[node]; id != -1; id = next_id_[id]) {
+            function(id);
+        }
+    }
 
 private:
-    void add_vertice_with_neighbour(int new_vertice, int existing_node);
+    void add_node(int node, int parent);
+    void add_vertice_with_neighbour(int new_id, int existing_id);
+    void attach(int id, int node);
+    void reserve_id(int id);
+    void increase_vertice_weight(int id, int value);
+    int lowest_common_ancestor(int u, int v) const;
+    void settle() const;
+
+    std::vector<int> vertex_weight_;
+    int total_vertex_weight_{0};
+
+    // Per id, -1 while detached
+    std::vector<int> id_to_node_;
+    std::vector<int> next_id_;
+
+    // Per node, indexed by the id naming it. A depth of 0 marks ids that
+    // don't name a node; roots have depth 1 and parent -1.
+    std::vector<int> parent_;
+    std::vector<int> depth_;
+    std::vector<int> jump_;
+    std::vector<int> root_;
+    std::vector<int> first_id_;
+    std::vector<int> nodes_;
 
-    std::unordered_set<int> detatched_ids_;
-    std::unordered_map<int, int> parent_node_;
-    std::unordered_map<int, int> id_to_node_;
-    std::unordered_map<int, int> node_depth_;
-    std::unordered_map<int, std::unordered_set<int>> ids_in_nodes_;
+    std::vector<int> node_increment_;
+    std::vector<int> edge_increment_;
+    mutable std::vector<int> subtree_node_weight_;
+    mutable std::vector<int> subtree_edge_weight_;
+    mutable bool settled_{true};
 };
 
 }
@@ -2,109 +2,139 @@
 
 namespace workload {
 
-ExecutionLog::ExecutionLog(int n_threads) {
-    for (auto i = 0; i < n_threads; i++) {
-        simulated_threads_[i] = Thread();
-        crossborder_requests_[i+1] = 0;
-    }
-}
+ExecutionLog::ExecutionLog(int n_threads)
+    : crossborder_requests_(n_threads + 1, 0),
+      elapsed_time_(n_threads, 0),
+      idle_time_(n_threads, 0),
+      executed_requests_(n_threads, 0),
+      timeline_end_(n_threads, 0),
+      busy_intervals_(n_threads)
+{}
 
 void ExecutionLog::increase_elapsed_time(int thread_id, int time/*=1*/) {
-    simulated_threads_[thread_id].elapsed_time_ += time;
+    elapsed_time_[thread_id] += time;
 }
 
 void ExecutionLog::execute_request(int thread_id, int execution_time/*=1*/) {
-    simulated_threads_[thread_id].executed_requests_ += 1;
+    auto& busy_intervals = busy_intervals_[thread_id];
+    auto& timeline_end = timeline_end_[thread_id];
+    executed_requests_[thread_id] += 1;
     processed_requests_ += 1;
-    for (auto i = 0; i < execution_time; i++) {
-        simulated_threads_[thread_id].executing_on_time_.push_back('1');
+    if (not busy_intervals.empty() and
+        busy_intervals.back().second == timeline_end)
+    {
+        busy_intervals.back().second += execution_time;
+    } else {
+        busy_intervals.emplace_back(timeline_end, timeline_end + execution_time);
     }
+    timeline_end += execution_time;
     increase_elapsed_time(thread_id, execution_time);
 }
 
 void ExecutionLog::sync_all_partitions() {
-    std::unordered_set<int> involved_threads;
-    for (auto i = 0; i < simulated_threads_.size(); i++) {
+    auto involved_threads = PartitionSet();
+    for (auto i = 0; i < n_threads(); i++) {
         involved_threads.insert(i);
     }
     sync_partitions(involved_threads);
 }
 
-void ExecutionLog::sync_partitions(
-    const std::unordered_set<int>& thread_ids
-) {
+void ExecutionLog::sync_partitions(const PartitionSet& thread_ids) {
     auto timeskip = max_elapsed_time(thread_ids);
     for (auto thread : thread_ids) {
         skip_time(thread, timeskip);
     }
-    crossborder_requests_[thread_ids.size()]++;
-    if (thread_ids.size() > 1) {
+    auto n_involved_threads = thread_ids.size();
+    crossborder_requests_[n_involved_threads]++;
+    if (n_involved_threads > 1) {
         sync_counter_++;
     }
 }
 
 void ExecutionLog::skip_time(int thread_id, int value) {
-    auto skipped_time = value - simulated_threads_[thread_id].elapsed_time_;
-    for (auto i = 0; i < skipped_time; i++) {
-        simulated_threads_.at(thread_id).executing_on_time_.push_back('\0');
+    auto skipped_time = value - elapsed_time_[thread_id];
+    if (skipped_time > 0) {
+        timeline_end_[thread_id] += skipped_time;
     }
-    simulated_threads_[thread_id].idle_time_ += skipped_time;
-    simulated_threads_[thread_id].elapsed_time_ = value;
+    idle_time_[thread_id] += skipped_time;
+    elapsed_time_[thread_id] = value;
 }
 
 void ExecutionLog::increase_sync_counter() {
     sync_counter_++;
 }
 
-int ExecutionLog::partition_with_longest_execution(const std::unordered_set<int>& partitions) const {
+// Ties go to the first partition in the list
+int ExecutionLog::partition_with_longest_execution(const PartitionSet& partitions) const {
     auto max = -1;
     auto partition = 0;
-    for (const auto& partition_id: partitions) {
-        const auto& thread = simulated_threads_.at(partition_id);
-        if (thread.elapsed_time_ > max) {
-            max = thread.elapsed_time_;
+    for (auto partition_id: partitions) {
+        if (elapsed_time_[partition_id] > max) {
+            max = elapsed_time_[partition_id];
             partition = partition_id;
         }
     }
     return partition;
 }
 
-std::vector<std::vector<char>> ExecutionLog::threads_execution_status_per_time() const {
-    std::vector<std::vector<char>> threads_status;
-    for (auto i = 0; i < simulated_threads_.size(); i++) {
-        threads_status.push_back(simulated_threads_.at(i).executing_on_time_);
+// Sweeps over the start and end of every busy interval, so the cost
+// depends on how many intervals there are and not on the makespan
+std::vector<BusyPeriod> ExecutionLog::busy_threads_per_time() const {
+    auto boundaries = std::vector<std::pair<int, int>>();
+    for (const auto& busy_intervals : busy_intervals_) {
+        for (const auto& interval : busy_intervals) {
+            boundaries.emplace_back(interval.first, 1);
+            boundaries.emplace_back(interval.second, -1);
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+
+    auto periods = std::vector<BusyPeriod>();
+    auto add_period = [&periods](int begin, int end, int busy_threads) {
+        if (begin >= end) {
+            return;
+        }
+        if (not periods.empty() and periods.back().busy_threads == busy_threads) {
+            periods.back().end = end;
+        } else {
+            periods.push_back(BusyPeriod{begin, end, busy_threads});
+        }
+    };
+
+    auto time = 0;
+    auto busy_threads = 0;
+    for (const auto& boundary : boundaries) {
+        add_period(time, boundary.first, busy_threads);
+        time = boundary.first;
+        busy_threads += boundary.second;
     }
-    return threads_status;
+    add_period(time, makespan(), busy_threads);
+
+    return periods;
 }
 
 
-int ExecutionLog::max_elapsed_time(
-    const std::unordered_set<int>& thread_ids
-) const {
+int ExecutionLog::max_elapsed_time(const PartitionSet& thread_ids) const {
     auto max = 0;
     for (auto id : thread_ids) {
-        auto elapsed_time = simulated_threads_.at(id).elapsed_time_;
-        if (elapsed_time > max) {
-            max = elapsed_time;
+        if (elapsed_time_[id] > max) {
+            max = elapsed_time_[id];
         }
     }
     return max;
 }
 
 int ExecutionLog::makespan() const {
-    auto longest_time = 0;
-    for (const auto& kv: simulated_threads_) {
-        const auto& thread = kv.second;
-        auto time = thread.elapsed_time_;
-        if (longest_time < time) {
-            longest_time = time;
-        }
+    if (elapsed_time_.empty()) {
+        return 0;
     }
-    return longest_time;
+    return std::max(
+        0, *std::max_element(elapsed_time_.begin(), elapsed_time_.end())
+    );
 }
 
 int ExecutionLog::n_threads() const {
-    return simulated_threads_.size();
+    return elapsed_time_.size();
 }
 
 int ExecutionLog::n_syncs() const {
@@ -116,54 +146,37 @@ int ExecutionLog::processed_requests() const {
 }
 
 int ExecutionLog::elapsed_time(int thread_id) const {
-    return simulated_threads_.at(thread_id).elapsed_time_;
+    return elapsed_time_.at(thread_id);
 }
 
 int ExecutionLog::idle_time() const {
+    auto makespan = this->makespan();
     auto total_time = 0;
-    for (const auto& kv : simulated_threads_) {
-        const auto& thread = kv.second;
-        auto time = thread.idle_time_;
-        total_time += time + (makespan() - thread.elapsed_time_);
+    for (auto thread_id = 0; thread_id < n_threads(); thread_id++) {
+        total_time += idle_time_[thread_id] + makespan - elapsed_time_[thread_id];
     }
     return total_time;
 }
 
-std::unordered_map<int, int> ExecutionLog::idle_time_per_thread() const {
-    auto idle_time = std::unordered_map<int, int>();
-
-    for (const auto& kv: simulated_threads_) {
-        auto thread_id = kv.first;
-        const auto& thread = kv.second;
-        idle_time[thread_id] = thread.idle_time_ + makespan() - thread.elapsed_time_;
+std::vector<int> ExecutionLog::idle_time_per_thread() const {
+    auto makespan = this->makespan();
+    auto idle_time = std::vector<int>(n_threads());
+    for (auto thread_id = 0; thread_id < n_threads(); thread_id++) {
+        idle_time[thread_id] =
+            idle_time_[thread_id] + makespan - elapsed_time_[thread_id];
     }
-
     return idle_time;
 }
 
-std::unordered_map<int, int> ExecutionLog::requests_per_thread() const {
-    auto requests = std::unordered_map<int, int>();
-
-    for (const auto& kv: simulated_threads_) {
-        auto thread_id = kv.first;
-        const auto& thread = kv.second;
-        requests[thread_id] = thread.executed_requests_;
-    }
-
-    return requests;
+const std::vector<int>& ExecutionLog::requests_per_thread() const {
+    return executed_requests_;
 }
 
-const std::unordered_map<int, int> ExecutionLog::execution_time() const{
-    auto elapsed_time = std::unordered_map<int, int>();
-    for (const auto& kv : simulated_threads_) {
-        auto thread_id = kv.first;
-        const auto& thread = kv.second;
-        elapsed_time[thread_id] = thread.elapsed_time_;
-    }
-    return elapsed_time;
+const std::vector<int>& ExecutionLog::execution_time() const {
+    return elapsed_time_;
 }
 
-const std::unordered_map<int, int>& ExecutionLog::crossborder_requests() const {
+const std::vector<int>& ExecutionLog::crossborder_requests() const {
     return crossborder_requests_;
 }
 
@@ -171,20 +184,106 @@ const std::vector<int>& ExecutionLog::cut_values() const {
     return cut_values_;
 }
 
+const std::vector<long long>& ExecutionLog::connectivity_values() const {
+    return connectivity_values_;
+}
+
 const std::vector<double>& ExecutionLog::unbalance_values() const {
     return unbalance_values_;
 }
 
+const std::vector<int>& ExecutionLog::repartition_lags() const {
+    return repartition_lags_;
+}
+
+int ExecutionLog::discarded_repartitions() const {
+    return discarded_repartitions_;
+}
+
+const std::vector<int>& ExecutionLog::migrated_values() const {
+    return migrated_values_;
+}
+
+const ExecutorStats& ExecutionLog::executor_stats() const {
+    return executor_stats_;
+}
+
+void ExecutionLog::register_executor_stats(const ExecutorStats& executor_stats) {
+    executor_stats_ = executor_stats;
+}
+
+// Simulated time between asking for a repartition and installing it
+void ExecutionLog::register_repartition_lag(int lag) {
+    repartition_lags_.push_back(lag);
+}
+
+void ExecutionLog::register_discarded_repartition() {
+    discarded_repartitions_++;
+}
+
+void ExecutionLog::register_migration(
+    const Migration& migration, int cost_per_value
+) {
+    migrated_values_.push_back(migration.moved_values);
+    if (cost_per_value == 0) {
+        return;
+    }
+    for (auto i = 0; i < migration.sent_values.size(); i++) {
+        auto moved_values =
+            migration.sent_values[i] + migration.received_values[i];
+        increase_elapsed_time(i, cost_per_value * moved_values);
+    }
+}
+
 void ExecutionLog::register_repartition(const PartitionManager& partition_manager) {
-    register_cut_value(partition_manager);
+    if (partition_manager.access_model() == model::HYPERGRAPH) {
+        register_connectivity_value(partition_manager);
+    } else {
+        register_cut_value(partition_manager);
+    }
     register_unbalance_value(partition_manager);
 }
 
+// (lambda - 1) metric: every net costs its weight times the number of
+// extra partitions it spans
+void ExecutionLog::register_connectivity_value(
+    const PartitionManager& partition_manager
+) {
+    const auto& hypergraph = partition_manager.access_hypergraph();
+    auto vertice_partition = std::vector<int>();
+    partition_manager.partition_table().for_each([&](int value, int partition) {
+        if (value >= vertice_partition.size()) {
+            vertice_partition.resize(value + 1, 0);
+        }
+        vertice_partition[value] = partition;
+    });
+
+    connectivity_values_.push_back(hypergraph.connectivity_cost(
+        vertice_partition, partition_manager.n_partitions()
+    ));
+}
+
+// Built with CHECK_CUT_VALUES, the tracked cut is checked against a full
+// recount of the access graph
 void ExecutionLog::register_cut_value(const PartitionManager& partition_manager) {
+#ifdef CHECK_CUT_VALUES
+    auto counted_cut_value = count_cut_value(partition_manager);
+    if (counted_cut_value != partition_manager.cut_value()) {
+        throw std::logic_error(
+            "tracked cut value " + std::to_string(partition_manager.cut_value()) +
+            " differs from the counted " + std::to_string(counted_cut_value)
+        );
+    }
+#endif
+    cut_values_.push_back(partition_manager.cut_value());
+}
+
+int ExecutionLog::count_cut_value(const PartitionManager& partition_manager) const {
     auto cut_value = 0;
-    for (auto kv: partition_manager.value_to_partition_map()) {
-        auto value = kv.first;
-        auto partition = kv.second;
+    partition_manager.partition_table().for_each([&](int value, int partition) {
+        if (not partition_manager.access_graph().exist_vertice(value)) {
+            return;
+        }
         const auto& neighbours_and_weight =
             partition_manager.access_graph().vertice_edges(value);
         for (auto neighbours_and_weight: neighbours_and_weight) {
@@ -195,31 +294,12 @@ void ExecutionLog::register_cut_value(const PartitionManager& partition_manager)
                 cut_value += weight;
             }
         }
-    }
-
-    cut_values_.push_back(cut_value);
+    });
+    return cut_value;
 }
 
 void ExecutionLog::register_unbalance_value(const PartitionManager& partition_manager) {
-    auto total_weight = 0;
-    for (const auto& partition: partition_manager.partitions()) {
-        total_weight += partition.weight();
-    }
-    auto ideal_partition_weight = (double) total_weight / partition_manager.n_partitions();
-
-    auto biggest_unbalance = 0;
-    for (const auto& partition: partition_manager.partitions()) {
-        auto partition_weight = partition.weight();
-        if (abs(partition_weight - ideal_partition_weight) > biggest_unbalance) {
-            biggest_unbalance = partition_weight - ideal_partition_weight;
-        }
-    }
-    auto unbalance_percentage = 100*biggest_unbalance/ideal_partition_weight;
-    if (unbalance_percentage < 0) {
-        unbalance_percentage *= -1;
-    }
-    unbalance_values_.push_back(unbalance_percentage);
+    unbalance_values_.push_back(partition_manager.unbalance());
 }
 
-
 }
@@ -1,16 +1,44 @@
 #ifndef WORKLOAD_EXECUTION_LOG_H
 #define WORKLOAD_EXECUTION_LOG_H
 
+#include <algorithm>
 #include <iostream>
-#include <unordered_map>
-#include <unordered_set>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "partition/partition_manager.h"
+#include "partition/partition_set.h"
 
 
 namespace workload {
 
+// [begin, end) stretch of time during which busy_threads threads executed
+struct BusyPeriod {
+    int begin;
+    int end;
+    int busy_threads;
+};
+
+// Measurements of a run on real worker threads. Scheduler latency is the
+// wall time from a request becoming ready to a worker starting it, time
+// queued behind other ready requests included.
+struct ExecutorStats {
+    int n_workers = 0;
+    long long executed_requests = 0;
+    double seconds = 0;
+    double throughput = 0;
+    long long latency_p50 = 0;
+    long long latency_p90 = 0;
+    long long latency_p99 = 0;
+    long long latency_max = 0;
+    // Failed compare-and-swaps on the ready queue, and polls that found it
+    // empty
+    long long push_retries = 0;
+    long long pop_retries = 0;
+    long long empty_polls = 0;
+};
+
 class ExecutionLog {
 public:
     ExecutionLog(int n_threads);
@@ -18,12 +46,19 @@ public:
     void increase_elapsed_time(int thread_id, int time=1);
     void execute_request(int thread_id, int execution_time=1);
     void sync_all_partitions();
-    void sync_partitions(const std::unordered_set<int>& thread_ids);
+    void sync_partitions(const PartitionSet& thread_ids);
     void skip_time(int thread, int value);
     void increase_sync_counter();
-    int partition_with_longest_execution(const std::unordered_set<int>& partitions) const;
-    int max_elapsed_time(const std::unordered_set<int>& thread_ids) const;
+    int partition_with_longest_execution(const PartitionSet& partitions) const;
+    int max_elapsed_time(const PartitionSet& thread_ids) const;
     void register_repartition(const PartitionManager& partition_manager);
+    void register_repartition_lag(int lag);
+    // A background repartition still computing when the requests ran out
+    void register_discarded_repartition();
+    // Every partition spends cost_per_value for each value it sends or
+    // receives
+    void register_migration(const Migration& migration, int cost_per_value);
+    void register_executor_stats(const ExecutorStats& executor_stats);
 
     int makespan() const;
     int n_threads() const;
@@ -31,33 +66,46 @@ public:
     int processed_requests() const;
     int elapsed_time(int thread_id) const;
     int idle_time() const;
-    std::unordered_map<int, int> idle_time_per_thread() const;
-    std::unordered_map<int, int> requests_per_thread() const;
-    const std::unordered_map<int, int> execution_time() const;
-    const std::unordered_map<int, int>& crossborder_requests() const;
+    std::vector<int> idle_time_per_thread() const;
+    const std::vector<int>& requests_per_thread() const;
+    const std::vector<int>& execution_time() const;
+    // Indexed by the number of partitions the requests involved
+    const std::vector<int>& crossborder_requests() const;
     const std::vector<int>& cut_values() const;
+    const std::vector<long long>& connectivity_values() const;
     const std::vector<double>& unbalance_values() const;
-    std::vector<std::vector<char>> threads_execution_status_per_time() const;
+    const std::vector<int>& repartition_lags() const;
+    int discarded_repartitions() const;
+    const std::vector<int>& migrated_values() const;
+    // n_workers is 0 if nothing ran on real threads
+    const ExecutorStats& executor_stats() const;
+    std::vector<BusyPeriod> busy_threads_per_time() const;
 
 private:
     void register_cut_value(const PartitionManager& partition_manager);
+    int count_cut_value(const PartitionManager& partition_manager) const;
+    void register_connectivity_value(const PartitionManager& partition_manager);
     void register_unbalance_value(const PartitionManager& partition_manager);
 
     int sync_counter_ = 0;
     int processed_requests_ = 0;
-    std::unordered_map<int, int> crossborder_requests_;
+    std::vector<int> crossborder_requests_;
     std::vector<int> cut_values_;
+    std::vector<long long> connectivity_values_;
     std::vector<double> unbalance_values_;
+    std::vector<int> repartition_lags_;
+    int discarded_repartitions_ = 0;
+    std::vector<int> migrated_values_;
+    ExecutorStats executor_stats_;
 
-    struct Thread {
-        int requests_exectued_ = 0;
-        int elapsed_time_ = 0;
-        int idle_time_ = 0;
-        int executed_requests_ = 0;
-
-        std::vector<char> executing_on_time_;
-    };
-    std::unordered_map<int, Thread> simulated_threads_;
+    // Simulated threads, one entry per thread id in each vector
+    std::vector<int> elapsed_time_;
+    std::vector<int> idle_time_;
+    std::vector<int> executed_requests_;
+    // Ticks a thread spends executing or idle go, in order, to its
+    // timeline; busy ticks are kept as merged [begin, end) intervals
+    std::vector<int> timeline_end_;
+    std::vector<std::vector<std::pair<int, int>>> busy_intervals_;
 };
 
 }
@@ -1,12 +1,18 @@
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <math.h>
 #include <memory>
 #include <metis.h>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <toml11/toml.hpp>
 #include <unordered_map>
+#include <vector>
 
 #include "manager/manager.h"
 #include "manager/cbase_manager.h"
@@ -14,9 +20,12 @@
 #include "manager/graph_cut_manager.h"
 #include "manager/min_cut_manager.hpp"
 #include "manager/tree_cut_manager.h"
+#include "graph/hypergraph.h"
 #include "log/execution_log.h"
 #include "partition/min_cut.h"
 #include "request/request_generation.h"
+#include "request/request_source.h"
+#include "request/trace_format.h"
 #include "write/write.h"
 
 typedef toml::basic_value<toml::discard_comments, std::unordered_map> toml_config;
@@ -37,7 +46,7 @@ const std::unordered_map<std::string, CutDataStructure> string_to_structure({
     {"SPANNING_TREE", CutDataStructure::SPANNING_TREE},
 });
 
-std::vector<workload::Request> generate_single_data_requests(
+std::unique_ptr<workload::RequestSource> single_data_request_source(
     const toml_config& config, workload::Manager& manager
 ) {
     const auto single_data_distributions = toml::find<std::vector<std::string>>(
@@ -47,7 +56,7 @@ std::vector<workload::Request> generate_single_data_requests(
         config, "workload", "requests", "single_data", "n_requests"
     );
 
-    auto requests = std::vector<workload::Request>();
+    auto sources = std::vector<std::unique_ptr<workload::RequestSource>>();
     auto binomial_counter = 0;
     for (auto i = 0; i < n_requests.size(); i++) {
         auto current_distribution_ = single_data_distributions[i];
@@ -55,21 +64,20 @@ std::vector<workload::Request> generate_single_data_requests(
             current_distribution_
         );
 
-        auto new_requests = std::vector<workload::Request>();
         if (current_distribution == rfunc::FIXED) {
             const auto requests_per_data = floor(n_requests[i]/manager.n_variables());
 
-            new_requests = workload::generate_fixed_data_requests(
+            sources.push_back(std::make_unique<workload::FixedDataRequestSource>(
                 manager.n_variables(), requests_per_data
-            );
+            ));
         } else if (current_distribution == rfunc::UNIFORM) {
             auto data_rand = rfunc::uniform_distribution_rand(
                 0, manager.n_variables()-1
             );
 
-            new_requests = workload::generate_single_data_requests(
-                n_requests[i], data_rand
-            );
+            sources.push_back(std::make_unique<workload::GeneratedRequestSource>(
+                n_requests[i], data_rand, rfunc::fixed_distribution(1)
+            ));
         } else if (current_distribution == rfunc::BINOMIAL) {
             const auto success_probability = toml::find<std::vector<double>>(
                 config, "workload", "requests", "single_data", "success_probability"
@@ -78,19 +86,19 @@ std::vector<workload::Request> generate_single_data_requests(
                 manager.n_variables()-1, success_probability[binomial_counter]
             );
 
-            new_requests = workload::generate_single_data_requests(
-                n_requests[i], data_rand
-            );
+            sources.push_back(std::make_unique<workload::GeneratedRequestSource>(
+                n_requests[i], data_rand, rfunc::fixed_distribution(1)
+            ));
             binomial_counter++;
         }
-
-        requests.insert(requests.end(), new_requests.begin(), new_requests.end());
     }
 
-    return requests;
+    return std::make_unique<workload::ConcatenatedRequestSource>(
+        std::move(sources)
+    );
 }
 
-std::vector<workload::Request> generate_multi_data_requests(
+std::unique_ptr<workload::RequestSource> multi_data_request_source(
     const toml_config& config, workload::Manager& manager
 ) {
     const auto n_requests = toml::find<std::vector<int>>(
@@ -115,10 +123,8 @@ std::vector<workload::Request> generate_multi_data_requests(
 
     auto size_binomial_counter = 0;
     auto data_binomial_counter = 0;
-    auto requests = std::vector<workload::Request>();
+    auto sources = std::vector<std::unique_ptr<workload::RequestSource>>();
     for (auto i = 0; i < n_requests.size(); i++) {
-        auto new_requests = std::vector<workload::Request>();
-
         auto size_distribution = rfunc::string_to_distribution.at(
             size_distribution_[i]
         );
@@ -158,52 +164,84 @@ std::vector<workload::Request> generate_multi_data_requests(
             data_binomial_counter++;
         }
 
-        new_requests = workload::generate_multi_data_requests(
-            n_requests[i],
-            manager.n_variables(),
-            data_rand,
-            size_rand
-        );
-        requests.insert(requests.end(), new_requests.begin(), new_requests.end());
+        sources.push_back(std::make_unique<workload::GeneratedRequestSource>(
+            n_requests[i], data_rand, size_rand
+        ));
     }
 
-    return requests;
+    return std::make_unique<workload::ConcatenatedRequestSource>(
+        std::move(sources)
+    );
 }
 
-void generate_random_requests(
+std::unique_ptr<workload::RequestSource> random_request_source(
     const toml_config& config, workload::Manager& manager
 ) {
-    auto single_data_requests = generate_single_data_requests(config, manager);
-    auto multi_data_requests = generate_multi_data_requests(config, manager);
-
     const auto single_data_pick_probability = toml::find<int>(
         config, "workload", "requests", "single_data_pick_probability"
     );
-    auto requests = workload::merge_requests(
-        single_data_requests,
-        multi_data_requests,
+    return std::make_unique<workload::MergedRequestSource>(
+        single_data_request_source(config, manager),
+        multi_data_request_source(config, manager),
         single_data_pick_probability
     );
-
-    manager.set_requests(requests);
 }
 
-void import_requests(const toml_config& config, workload::Manager& manager) {
+std::unique_ptr<workload::RequestSource> imported_request_source(
+    const toml_config& config,
+    workload::Manager& manager,
+    double& trace_throughput
+) {
     auto import_path = toml::find<std::string>(
         config, "workload", "requests", "import_path"
     );
-    auto requests = std::move(workload::import_requests(import_path, manager.n_variables()));
-    //std::cout << "Imported" << requests.size() << " requests" << std::endl;
-    manager.set_requests(requests);
+    if (workload::is_binary_trace(import_path)) {
+        return std::make_unique<workload::BinaryTraceRequestSource>(import_path);
+    }
+    return std::make_unique<workload::FileRequestSource>(
+        import_path,
+        manager.n_variables(),
+        std::thread::hardware_concurrency(),
+        &trace_throughput
+    );
+}
+
+// Requests are produced on another thread, at most buffer_size of them
+// ahead of the execution
+std::unique_ptr<workload::RequestSource> buffered_request_source(
+    const toml_config& config,
+    workload::Manager& manager,
+    double& trace_throughput
+) {
+    const auto should_import_requests = toml::find<bool>(
+        config, "workload", "requests", "import_requests"
+    );
+    auto request_source = std::unique_ptr<workload::RequestSource>();
+    if (should_import_requests) {
+        request_source = imported_request_source(
+            config, manager, trace_throughput
+        );
+    } else {
+        request_source = random_request_source(config, manager);
+    }
+
+    const auto& requests = toml::find(config, "workload", "requests");
+    const auto buffer_size = toml::find_or(requests, "buffer_size", 4096);
+    return std::make_unique<workload::BufferedRequestSource>(
+        std::move(request_source), buffer_size
+    );
 }
 
 void export_requests(const toml_config& config, workload::Manager& manager) {
     const auto output_path = toml::find<std::string>(
         config, "output", "requests", "output_path"
     );
-    std::ofstream ofs(output_path, std::ofstream::out);
-    manager.export_requests(ofs);
-    ofs.close();
+    const auto& requests = toml::find(config, "output", "requests");
+    const auto format_name = toml::find_or(
+        requests, "format", std::string("BINARY")
+    );
+    const auto format = workload::string_to_trace_format.at(format_name);
+    manager.export_requests(output_path, format);
 }
 
 void export_execution_info(
@@ -213,11 +251,23 @@ void export_execution_info(
     const auto output_path = toml::find<std::string>(
         config, "output", "info_path"
     );
+    const auto& output = toml::find(config, "output");
+    const auto compress_busy_threads = toml::find_or(
+        output, "compress_busy_threads", false
+    );
     std::ofstream output_stream(output_path, std::ofstream::out);
-    output::write_log_info(execution_log, output_stream);
+    output::write_log_info(execution_log, output_stream, compress_busy_threads);
     output_stream.close();
 }
 
+model::AccessModel get_access_model(const toml_config& config) {
+    const auto& execution = toml::find(config, "execution");
+    const auto access_model_name = toml::find_or(
+        execution, "access_model", std::string("CLIQUE")
+    );
+    return model::string_to_access_model.at(access_model_name);
+}
+
 void set_base_manager_configuration(
     workload::Manager& manager, const toml_config& config
 ) {
@@ -240,6 +290,16 @@ void set_cbase_manager_configuration(
         config, "execution", "n_threads"
     );
     manager.set_n_threads(n_threads);
+
+    const auto& execution = toml::find(config, "execution");
+    const auto window_size = toml::find_or(execution, "window_size", 0);
+    manager.set_window_size(window_size);
+
+    const auto mode_name = toml::find_or(
+        execution, "cbase_mode", std::string("SIMULATED")
+    );
+    manager.set_mode(workload::string_to_cbase_mode.at(mode_name));
+    manager.set_request_cost(toml::find_or(execution, "request_cost", 0));
 }
 
 void set_early_min_cut_configuration(
@@ -254,6 +314,7 @@ void set_early_min_cut_configuration(
     );
     manager.set_n_partitions(n_partitions);
     manager.set_repartition_window(repartition_window);
+    manager.set_access_model(get_access_model(config));
 }
 
 void set_min_cut_configuration(
@@ -274,10 +335,23 @@ void set_min_cut_configuration(
         config, "workload", "initial_partitions", "n_partitions"
     );
     manager.initialize_partitions(n_partitions);
+    manager.set_access_model(get_access_model(config));
     const auto repartition_interval = toml::find<int>(
         config, "execution", "repartition_interval"
     );
     manager.set_repartition_interval(repartition_interval);
+
+    const auto& execution = toml::find(config, "execution");
+    const auto repartition_lag = toml::find_or(execution, "repartition_lag", 0);
+    manager.set_repartition_lag(repartition_lag);
+    manager.set_migration_cost(toml::find_or(execution, "migration_cost", 0));
+    manager.set_relabel_partitions(
+        toml::find_or(execution, "relabel_partitions", true)
+    );
+    manager.set_decay(
+        toml::find_or(execution, "decay_half_life", 0),
+        toml::find_or(execution, "decay_min_weight", 1)
+    );
 }
 
 void set_graph_cut_configuration(
@@ -289,6 +363,19 @@ void set_graph_cut_configuration(
     );
     const auto cut_method = model::string_to_cut_method.at(cut_method_name);
     manager.set_cut_method(cut_method);
+
+    const auto& execution = toml::find(config, "execution");
+    auto fennel_options = model::FennelOptions();
+    fennel_options.passes = toml::find_or(execution, "fennel_passes", 1);
+    fennel_options.order = model::string_to_vertex_order.at(
+        toml::find_or(execution, "fennel_order", std::string("ID"))
+    );
+    fennel_options.seed = toml::find_or(execution, "fennel_seed", 0);
+    fennel_options.n_threads = toml::find_or(execution, "fennel_threads", 1);
+    fennel_options.migration_penalty = toml::find_or(
+        execution, "fennel_migration_penalty", 0.0
+    );
+    manager.set_fennel_options(fennel_options);
 }
 
 void set_tree_cut_configuration(
@@ -340,19 +427,144 @@ std::unique_ptr<workload::Manager> get_manager(const toml_config& config) {
     return std::unique_ptr<workload::Manager>(nullptr);
 }
 
+// Parameters [sweep] may list several values for, by their place in the
+// config
+const std::vector<std::vector<std::string>> SWEEP_PARAMETERS({
+    {"workload", "initial_partitions", "n_partitions"},
+    {"execution", "repartition_interval"},
+    {"execution", "cut_method"}
+});
+
+// One config per combination of the values listed in [sweep], the first
+// parameter varying slowest. Parameters not listed keep their value.
+std::vector<toml_config> sweep_configs(const toml_config& config) {
+    const auto& sweep = toml::find(config, "sweep");
+    auto configs = std::vector<toml_config>({config});
+    for (const auto& path : SWEEP_PARAMETERS) {
+        const auto values = toml::find_or(
+            sweep, path.back(), std::vector<toml_config>()
+        );
+        if (values.empty()) {
+            continue;
+        }
+
+        auto combinations = std::vector<toml_config>();
+        for (const auto& base : configs) {
+            for (const auto& value : values) {
+                auto combination = base;
+                auto* table = &combination.as_table();
+                for (auto i = 0; i < path.size() - 1; i++) {
+                    table = &(*table)[path[i]].as_table();
+                }
+                (*table)[path.back()] = value;
+                combinations.push_back(std::move(combination));
+            }
+        }
+        configs = std::move(combinations);
+    }
+    return configs;
+}
+
+// Empty if the config doesn't have the parameter
+std::string sweep_parameter(
+    const toml_config& config, const std::vector<std::string>& path
+) {
+    const auto* value = &config;
+    for (const auto& key : path) {
+        if (not value->is_table() or value->as_table().count(key) == 0) {
+            return "";
+        }
+        value = &value->as_table().at(key);
+    }
+    auto parameter = std::ostringstream();
+    parameter << *value;
+    return parameter.str();
+}
+
+// Runs every combination of the [sweep] parameters, n_threads at a time,
+// on a workload loaded once and shared by all of them. Writes one CSV row
+// per combination, in the order sweep_configs gives them.
+void run_sweep(const toml_config& config) {
+    const auto configs = sweep_configs(config);
+    const auto& sweep = toml::find(config, "sweep");
+    const auto n_threads = toml::find_or(
+        sweep, "n_threads", int(std::thread::hardware_concurrency())
+    );
+    const auto output_path = toml::find<std::string>(sweep, "output_path");
+
+    auto trace_throughput = 0.0;
+    const auto loader = get_manager(configs.front());
+    const auto requests = std::make_shared<const std::vector<workload::Request>>(
+        workload::collect_requests(*buffered_request_source(
+            configs.front(), *loader, trace_throughput
+        ))
+    );
+
+    auto rows = std::vector<std::string>(configs.size());
+    auto next_run = std::atomic<std::size_t>(0);
+    auto failure = std::exception_ptr();
+    auto failure_mutex = std::mutex();
+    auto run = [&]() {
+        for (auto i = next_run++; i < configs.size(); i = next_run++) {
+            try {
+                const auto manager = get_manager(configs[i]);
+                manager->set_request_source(
+                    std::make_unique<workload::SharedRequestSource>(requests)
+                );
+                const auto execution_log = manager->execute_requests();
+
+                auto row = std::ostringstream();
+                for (const auto& path : SWEEP_PARAMETERS) {
+                    row << sweep_parameter(configs[i], path) << ",";
+                }
+                output::write_log_summary(execution_log, row);
+                rows[i] = row.str();
+            } catch (...) {
+                auto lock = std::lock_guard<std::mutex>(failure_mutex);
+                if (not failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    };
+
+    auto workers = std::vector<std::thread>();
+    for (auto i = 1; i < n_threads; i++) {
+        workers.emplace_back(run);
+    }
+    run();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    std::ofstream output_stream(output_path, std::ofstream::out);
+    for (const auto& path : SWEEP_PARAMETERS) {
+        output_stream << path.back() << ",";
+    }
+    output_stream << output::LOG_SUMMARY_HEADER << "\n";
+    for (const auto& row : rows) {
+        output_stream << row;
+    }
+    output_stream.close();
+}
+
 int main(int argc, char* argv[]) {
     const auto config = toml::parse(argv[1]);
 
+    if (config.as_table().count("sweep") != 0) {
+        run_sweep(config);
+        return 0;
+    }
+
     const auto manager = get_manager(config);
 
-    const auto should_import_requests = toml::find<bool>(
-        config, "workload", "requests", "import_requests"
+    auto trace_throughput = 0.0;
+    manager->set_request_source(
+        buffered_request_source(config, *manager, trace_throughput)
     );
-    if (should_import_requests) {
-        import_requests(config, *manager);
-    } else {
-        generate_random_requests(config, *manager);
-    }
 
     const auto should_export_requests = toml::find<bool>(
         config, "output", "requests", "export"
@@ -371,5 +583,11 @@ int main(int argc, char* argv[]) {
     auto execution_log = manager->execute_requests();
     export_execution_info(config, execution_log);
 
+    // only CSV traces are parsed
+    if (trace_throughput != 0) {
+        std::cout << "Trace parsed at " << trace_throughput << " MB/s"
+                  << std::endl;
+    }
+
     return 0;
 }
@@ -2,30 +2,56 @@
 
 namespace workload {
 
-CBaseManager::CBaseManager(int n_variables, int n_threads):
+CBaseManager::CBaseManager(
+    int n_variables, int n_threads, int window_size /*= 0*/
+):
     Manager{n_variables},
-    n_threads_{n_threads}
+    n_threads_{n_threads},
+    window_size_{window_size}
 {}
 
+// Requests are admitted from the source while the dependency window has
+// room. One admitted after a request executed can't be ready before that
+// execution ended.
 ExecutionLog CBaseManager::execute_requests() {
     auto log = ExecutionLog(n_threads_);
-    auto graph = generate_dependency_graph();
+    if (mode_ == THREADED) {
+        auto requests = collect_requests(*request_source_);
+        auto executor = simulation::ThreadedExecutor(n_threads_, request_cost_);
+        log.register_executor_stats(executor.run(requests));
+        request_source_ = std::make_unique<VectorRequestSource>(
+            std::move(requests)
+        );
+    }
+
     auto threads_heap = initialize_threads_heap();
-    auto font_heap = initialize_font_heap(graph);
+    auto font_heap = Heap();
+    auto window = simulation::DependencyWindow(n_variables_);
+
+    auto request = Request();
+    auto has_requests = true;
+    auto admit_requests = [&](int not_before) {
+        while (has_requests and
+               (window_size_ == 0 or window.size() < window_size_))
+        {
+            has_requests = request_source_->next(request);
+            if (has_requests) {
+                window.admit(request, not_before, font_heap);
+            }
+        }
+    };
+    admit_requests(0);
 
-    auto counter = 0;
     while (!font_heap.empty()) {
         // choose request to execute
-        auto p = font_heap.top();
-        font_heap.pop();
-        auto request_ready_moment = p.first;
-        auto vertice_id = p.second;
+        auto p = font_heap.pop();
+        auto request_ready_moment = p.time;
+        auto slot = p.target;
 
         // choose thread to execute it
         auto t = threads_heap.top();
-        threads_heap.pop();
-        auto thread_elapsed_time = t.first;
-        auto thread_id = t.second;
+        auto thread_elapsed_time = t.time;
+        auto thread_id = t.key;
 
         // execute request
         if (request_ready_moment > thread_elapsed_time) {
@@ -33,26 +59,15 @@ ExecutionLog CBaseManager::execute_requests() {
         }
         log.increase_elapsed_time(thread_id);
 
-        // update graph and add new ready requests to heap
-	auto edges = graph.vertice_edges(vertice_id);
-	for (auto& kv : edges) {
-            auto neighbour = kv.first;
-
-            auto new_neighbour_weight = graph.vertice_weight(vertice_id) + 1;
-            if (new_neighbour_weight > graph.vertice_weight(neighbour)) {
-                graph.set_vertice_weight(neighbour, new_neighbour_weight);
-            }
-
-            graph.remove_edge(vertice_id, neighbour);
-            if (graph.in_degree(neighbour) == 0) {
-                auto p = std::make_pair(graph.vertice_weight(neighbour), neighbour);
-                font_heap.push(p);
-            }
-        }
-        graph.remove_vertice(vertice_id);
+        // add new ready requests to heap
+        window.retire(slot, font_heap);
 
         // update thread queue
-        threads_heap.push(std::make_pair(log.elapsed_time(thread_id), thread_id));
+        threads_heap.replace_top(
+            simulation::Event{log.elapsed_time(thread_id), thread_id, 0, 0}
+        );
+
+        admit_requests(log.elapsed_time(thread_id));
     }
 
     return log;
@@ -61,50 +76,25 @@ ExecutionLog CBaseManager::execute_requests() {
 Heap CBaseManager::initialize_threads_heap() {
     auto heap = Heap();
     for (auto i = 0; i < n_threads_; i++) {
-        auto p = std::make_pair(0, i);
-        heap.push(p);
+        heap.push(simulation::Event{0, i, 0, 0});
     }
     return heap;
 }
 
-Heap CBaseManager::initialize_font_heap(const model::Graph& graph) {
-    auto heap = Heap();
-    for (auto kv : graph.in_degrees()) {
-        auto vertice_id = kv.first;
-        auto in_degree = kv.second;
-        if (in_degree == 0) {
-            heap.push(std::make_pair(0, vertice_id));
-        }
-    }
-    return heap;
+void CBaseManager::set_n_threads(int n_threads) {
+    n_threads_ = n_threads;
 }
 
-model::Graph CBaseManager::generate_dependency_graph() {
-    auto last_vertice_with_variable = std::unordered_map<int, int>();
-    auto vertex_counter = 0;
-    auto dependency_graph = model::Graph();
-
-    for (auto request : requests_) {
-        dependency_graph.add_vertice(vertex_counter);
-
-        for (auto variable : request) {
-            if (last_vertice_with_variable.find(variable) != last_vertice_with_variable.end()) {
-                auto neighbour = last_vertice_with_variable[variable];
-                if (!dependency_graph.are_connected(neighbour, vertex_counter)) {
-                    dependency_graph.add_edge(neighbour, vertex_counter);
-                }
-            }
-            last_vertice_with_variable[variable] = vertex_counter;
-        }
-
-        vertex_counter++;
-    }
+void CBaseManager::set_window_size(int window_size) {
+    window_size_ = window_size;
+}
 
-    return dependency_graph;
+void CBaseManager::set_mode(CBaseMode mode) {
+    mode_ = mode;
 }
 
-void CBaseManager::set_n_threads(int n_threads) {
-    n_threads_ = n_threads;
+void CBaseManager::set_request_cost(int request_cost) {
+    request_cost_ = request_cost;
 }
 
 void CBaseManager::export_data(std::string output_path) {
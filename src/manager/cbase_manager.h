@@ -2,42 +2,55 @@
 #define WORKLOAD_CBASE_MANAGER_H
 
 #include <deque>
-#include <queue>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include "log/execution_log.h"
-#include "graph/graph.h"
 #include "manager.h"
 #include "request/random.h"
-
+#include "simulation/dependency_window.h"
+#include "simulation/event_queue.h"
+#include "simulation/threaded_executor.h"
 
 namespace workload {
 
-typedef std::priority_queue<
-    std::pair<int, int>,
-    std::vector<std::pair<int, int>>,
-    std::greater<std::pair<int, int>>
-> Heap;
+// Events keyed by (time, id): requests by their ready moment and request
+// id, threads by their elapsed time and thread id
+typedef simulation::EventQueue Heap;
+
+// THREADED also runs the requests on real threads, see
+// simulation::ThreadedExecutor, and adds its measurements to the log
+enum CBaseMode {SIMULATED, THREADED};
+const std::unordered_map<std::string, CBaseMode> string_to_cbase_mode({
+    {"SIMULATED", SIMULATED},
+    {"THREADED", THREADED}
+});
 
 class CBaseManager : public Manager {
 public:
     CBaseManager() = default;
-    CBaseManager(int n_variables, int n_threads);
+    CBaseManager(int n_variables, int n_threads, int window_size = 0);
 
     ExecutionLog execute_requests();
-    model::Graph generate_dependency_graph();
     void export_data(std::string output_path);
 
     void set_n_threads(int n_threads);
+    // At most window_size requests are in the dependency graph at once,
+    // 0 for no limit
+    void set_window_size(int window_size);
+    void set_mode(CBaseMode mode);
+    // Nanoseconds each request keeps a real thread busy
+    void set_request_cost(int request_cost);
 
 private:
     Heap initialize_threads_heap();
-    Heap initialize_font_heap(const model::Graph& graph);
 
     int n_threads_;
+    int window_size_{0};
+    CBaseMode mode_{SIMULATED};
+    int request_cost_{0};
 };
 
 }
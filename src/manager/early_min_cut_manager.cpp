@@ -36,40 +36,69 @@ void EarlyMinCutManager::update_graph(
     }
 }
 
+void EarlyMinCutManager::update_hypergraph(
+    model::Hypergraph& hypergraph, const Request& request
+) const {
+    for (auto data : request) {
+        hypergraph.increase_vertice_weight(data);
+    }
+    hypergraph.add_net(std::vector<int>(request.begin(), request.end()));
+}
+
 ExecutionLog EarlyMinCutManager::execute_requests() {
     auto log = ExecutionLog(n_partitions_);
-
-    while (!requests_.empty()) {
+    auto engine = simulation::Engine(log, simulation::EXECUTE_ON_ALL);
+    auto involved_partitions = PartitionSet();
+    // reused by every batch, only the values a batch set are reset
+    auto data_partition = PartitionTable(n_variables_);
+
+    auto request = Request();
+    auto has_requests = request_source_->next(request);
+    while (has_requests) {
         auto batch = std::vector<Request>();
         auto batch_graph = model::Graph();
-        while (batch.size() != repartition_window_ and !requests_.empty()) {
-            auto request = requests_.front();
-            requests_.pop_front();
+        auto batch_hypergraph = model::Hypergraph();
+        while (batch.size() != repartition_window_ and has_requests) {
             batch.push_back(request);
-            update_graph(batch_graph, request);
+            if (access_model_ == model::HYPERGRAPH) {
+                update_hypergraph(batch_hypergraph, request);
+            } else {
+                update_graph(batch_graph, request);
+            }
+            has_requests = request_source_->next(request);
+        }
+
+        auto partition_scheme = std::vector<Partition>();
+        if (access_model_ == model::HYPERGRAPH) {
+            partition_scheme = model::hypergraph_fennel_cut(
+                batch_hypergraph, n_partitions_
+            );
+        } else {
+            partition_scheme = model::fennel_cut(batch_graph, n_partitions_);
         }
 
-        auto partition_scheme = model::fennel_cut(batch_graph, n_partitions_);
+        for (auto i = 0; i < partition_scheme.size(); i++) {
+            for (auto data : partition_scheme[i].data()) {
+                data_partition.set(data, i);
+            }
+        }
 
-        for (auto& request : batch) {
-            auto involved_partitions = std::unordered_set<int>();
-            for (auto data : request) {
-                for (auto i = 0; i < partition_scheme.size(); i++) {
-                    const auto& partition = partition_scheme.at(i);
-                    if (partition.contains(data)) {
-                        involved_partitions.insert(i);
-                    }
+        for (const auto& batch_request : batch) {
+            involved_partitions.clear();
+            for (auto data : batch_request) {
+                auto partition = data_partition.get(data);
+                if (partition != -1) {
+                    involved_partitions.insert(partition);
                 }
             }
 
-            if (involved_partitions.size() == 1) {
-                auto partition = *(involved_partitions.begin());
-                log.increase_elapsed_time(partition);
-            } else {
-                log.sync_partitions(involved_partitions);
-                for (auto partition : involved_partitions) {
-                    log.increase_elapsed_time(partition);
-                }
+            engine.submit(involved_partitions);
+            engine.run();
+        }
+
+        for (const auto& partition : partition_scheme) {
+            for (auto data : partition.data()) {
+                data_partition.erase(data);
             }
         }
     }
@@ -85,6 +114,10 @@ void EarlyMinCutManager::set_n_partitions(int n_partitions) {
     n_partitions_ = n_partitions;
 }
 
+void EarlyMinCutManager::set_access_model(model::AccessModel access_model) {
+    access_model_ = access_model;
+}
+
 void EarlyMinCutManager::export_data(std::string output_path) {
 
 }
@@ -8,9 +8,13 @@
 
 #include "log/execution_log.h"
 #include "graph/graph.h"
+#include "graph/hypergraph.h"
 #include "partition/min_cut.h"
+#include "partition/partition_set.h"
+#include "partition/partition_table.h"
 #include "manager.h"
 #include "request/random.h"
+#include "simulation/engine.h"
 
 namespace workload {
 
@@ -27,15 +31,20 @@ public:
     void update_graph(
         model::Graph& graph, const Request& request
     ) const;
+    void update_hypergraph(
+        model::Hypergraph& hypergraph, const Request& request
+    ) const;
 
     void set_repartition_window(int repartition_window);
     void set_n_partitions(int n_partitions);
+    void set_access_model(model::AccessModel access_model);
 
     void export_data(std::string output_path);
 
 protected:
     int repartition_window_;
     int n_partitions_;
+    model::AccessModel access_model_{model::CLIQUE};
 };
 
 }
@@ -11,9 +11,10 @@ GraphCutManager::GraphCutManager(
     :   MinCutManager{
             n_variables, n_partitions,
             repartition_interval, data_partition
-        },
-        cut_method_{cut_method}
-{}
+        }
+{
+    set_cut_method(cut_method);
+}
 
 // Distribute data in partitions with round-robin
 GraphCutManager::GraphCutManager(
@@ -24,37 +25,79 @@ GraphCutManager::GraphCutManager(
     :   MinCutManager{
             n_variables, n_partitions,
             repartition_interval
-        },
-        cut_method_{cut_method}
-{}
+        }
+{
+    set_cut_method(cut_method);
+}
 
 void GraphCutManager::set_cut_method(model::CutMethod cut_method) {
     cut_method_ = cut_method;
+    if (cut_method_ == model::HYPERGRAPH_FENNEL) {
+        set_access_model(model::HYPERGRAPH);
+    }
 }
 
-void GraphCutManager::repartition_data(int n_partitions) {
-    if (cut_method_ == model::FENNEL) {
-        partition_manager_.update_partitions(
-            model::fennel_cut(
-                partition_manager_.access_graph(),
-                partition_manager_.n_partitions()
-            )
+void GraphCutManager::set_fennel_options(
+    const model::FennelOptions& fennel_options
+) {
+    fennel_options_ = fennel_options;
+    refennel_partitioner_.set_options(fennel_options);
+}
+
+std::vector<Partition> compute_partitions(
+    PartitionManager& partition_manager,
+    model::CutMethod cut_method,
+    const model::FennelOptions& fennel_options,
+    model::RefennelPartitioner& refennel_partitioner
+) {
+    if (cut_method == model::HYPERGRAPH_FENNEL) {
+        return model::hypergraph_fennel_cut(
+            partition_manager.access_hypergraph(),
+            partition_manager.n_partitions()
         );
-    } else if (cut_method_ == model::REFENNEL) {
-        partition_manager_.update_partitions(
-            model::refennel_cut(partition_manager_)
+    } else if (cut_method == model::FENNEL) {
+        return model::fennel_cut(
+            partition_manager.compacted_access_graph(),
+            partition_manager.n_partitions(),
+            fennel_options,
+            partition_manager.access_order()
         );
+    } else if (cut_method == model::REFENNEL) {
+        partition_manager.compacted_access_graph();
+        return refennel_partitioner.cut(partition_manager);
     } else {
-        partition_manager_.update_partitions(
-            model::multilevel_cut(
-                partition_manager_.access_graph(),
-                partition_manager_.n_partitions(),
-                cut_method_
-            )
+        return model::multilevel_cut(
+            partition_manager.compacted_access_graph(),
+            partition_manager.n_partitions(),
+            cut_method
         );
     }
 }
 
+void GraphCutManager::repartition_data(int n_partitions) {
+    partition_manager_.update_partitions(
+        compute_partitions(
+            partition_manager_, cut_method_,
+            fennel_options_, refennel_partitioner_
+        )
+    );
+}
+
+// The job borrows the REFENNEL partitioner: execute_requests never has two
+// repartitions in flight, and explicitly waits on the last one before
+// returning
+std::function<std::vector<Partition>()> GraphCutManager::repartition_job() {
+    auto snapshot = std::make_shared<PartitionManager>(partition_manager_);
+    auto cut_method = cut_method_;
+    auto fennel_options = fennel_options_;
+    auto* refennel_partitioner = &refennel_partitioner_;
+    return [snapshot, cut_method, fennel_options, refennel_partitioner]() {
+        return compute_partitions(
+            *snapshot, cut_method, fennel_options, *refennel_partitioner
+        );
+    };
+}
+
 void GraphCutManager::export_data(std::string output_path) {
     std::ofstream output_stream(output_path, std::ofstream::out);
     auto partitions_graph = partition_manager_.graph_representation();
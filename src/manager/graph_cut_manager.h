@@ -1,10 +1,13 @@
 #ifndef WORKLOAD_GRAPH_CUT_MANAGER_H
 #define WORKLOAD_GRAPH_CUT_MANAGER_H
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "graph/graph.h"
 #include "partition/min_cut.h"
+#include "partition/refennel_partitioner.h"
 #include "min_cut_manager.hpp"
 
 namespace workload {
@@ -27,11 +30,15 @@ public:
     );
 
     void set_cut_method(model::CutMethod cut_method);
+    void set_fennel_options(const model::FennelOptions& fennel_options);
     void repartition_data(int n_partitions);
+    std::function<std::vector<Partition>()> repartition_job();
     void export_data(std::string output_path);
 
 private:
     model::CutMethod cut_method_;
+    model::FennelOptions fennel_options_;
+    model::RefennelPartitioner refennel_partitioner_;
 
 };
 
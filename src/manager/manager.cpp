@@ -6,37 +6,46 @@ Manager::Manager(int n_variables):
     n_variables_{n_variables}
 {}
 
-void Manager::add_request(Request request) {
-    requests_.push_back(request);
+void Manager::set_request_source(std::unique_ptr<RequestSource> request_source) {
+    request_source_ = std::move(request_source);
 }
 
-void Manager::export_requests(std::ostream& output_stream) {
-    toml::array toml_array;
-    for (auto request : requests_) {
-        toml_array.push_back(request);
+// The exported workload is still executed afterwards. Binary traces are
+// streamed to the file and read back from it, TOML ones need the whole
+// workload in memory.
+void Manager::export_requests(
+    std::string output_path, TraceFormat format /*= BINARY*/
+) {
+    std::ofstream output_stream(
+        output_path, std::ofstream::out | std::ofstream::binary
+    );
+    if (format == BINARY) {
+        write_binary_trace(output_stream, *request_source_, n_variables_);
+        output_stream.close();
+        request_source_ = std::make_unique<BinaryTraceRequestSource>(
+            output_path
+        );
+    } else {
+        auto requests = collect_requests(*request_source_);
+        write_toml_trace(output_stream, requests);
+        output_stream.close();
+        request_source_ = std::make_unique<VectorRequestSource>(
+            std::move(requests)
+        );
     }
-    const toml::value data(toml_array);
-    output_stream << "requests = ";
-    output_stream << std::setw(80) << data << std::endl;
 }
 
-// Maybe import should be done by stream too,
-// I'll do it with toml just for simplicity
-// to reuse the parser
+// Binary traces are streamed, TOML ones are still parsed whole
 void Manager::import_requests(std::string input_path) {
-    const auto requests_file = toml::parse(input_path);
-    const auto requests_vector = toml::find<std::vector<std::vector<int>>>(requests_file, "requests");
-    for (auto request_vector : requests_vector) {
-        auto request = Request(request_vector.begin(), request_vector.end());
-        requests_.push_back(request);
+    if (is_binary_trace(input_path)) {
+        request_source_ = std::make_unique<BinaryTraceRequestSource>(input_path);
+    } else {
+        set_requests(read_toml_trace(input_path));
     }
 }
 
 void Manager::set_requests(const std::vector<Request>& requests) {
-    for (auto request_vector : requests) {
-        auto request = Request(request_vector.begin(), request_vector.end());
-        requests_.push_back(request);
-    }
+    request_source_ = std::make_unique<VectorRequestSource>(requests);
 }
 
 void Manager::set_requests_execution_time(int requests_execution_time) {
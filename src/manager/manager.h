@@ -1,11 +1,14 @@
 #ifndef WORKLOAD_MANAGER_H
 #define WORKLOAD_MANAGER_H
 
-#include <deque>
+#include <fstream>
+#include <memory>
 #include <string>
 #include <toml11/toml.hpp>
 
 #include "request/request_generation.h"
+#include "request/request_source.h"
+#include "request/trace_format.h"
 #include "log/execution_log.h"
 #include "write/write.h"
 
@@ -19,10 +22,12 @@ public:
     virtual ExecutionLog execute_requests() = 0;
     virtual void export_data(std::string output_path) = 0;
 
-    void add_request(Request request);
+    void set_request_source(std::unique_ptr<RequestSource> request_source);
     void set_requests(const std::vector<Request>& requests);
     void set_requests_execution_time(int requests_execution_time);
-    void export_requests(std::ostream& output_stream);
+    void export_requests(
+        std::string output_path, TraceFormat format = BINARY
+    );
     void import_requests(std::string input_path);
 
     int n_variables();
@@ -31,7 +36,9 @@ public:
 protected:
     int n_variables_{0};
     int requests_execution_time_{1};
-    std::deque<Request> requests_;
+    std::unique_ptr<RequestSource> request_source_{
+        std::make_unique<VectorRequestSource>()
+    };
 };
 
 }
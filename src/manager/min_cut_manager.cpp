@@ -31,55 +31,76 @@ void MinCutManager::initialize_partitions(int n_partitions) {
 
 ExecutionLog MinCutManager::execute_requests() {
     auto log = ExecutionLog(partition_manager_.n_partitions());
-
-    while (!requests_.empty()) {
-        auto request = requests_.front();
-        requests_.pop_front();
-
-        auto involved_partitions = get_involved_partitions(request);
-        auto executing_partition = log.partition_with_longest_execution(
-            involved_partitions
-        );
-        log.execute_request(executing_partition, requests_execution_time_);
-        if (involved_partitions.size() > 1) {
-            log.sync_partitions(involved_partitions);
-        }
-
-        for (auto partition: involved_partitions) {
-            if (partition == executing_partition) {
-                continue;
-            }
-
-            log.increase_elapsed_time(partition, requests_execution_time_);
-        }
-
-
+    auto engine = simulation::Engine(
+        log, simulation::EXECUTE_ON_LONGEST, requests_execution_time_
+    );
+
+    auto pending_repartition = std::future<std::vector<Partition>>();
+    auto install_at = 0;
+    auto requested_at_time = 0;
+
+    auto request = Request();
+    while (request_source_->next(request)) {
+        get_involved_partitions(request, involved_partitions_);
+        engine.submit(involved_partitions_);
         partition_manager_.register_access(request);
+        engine.run();
+
+        auto processed_requests = engine.submitted_requests();
+        if (pending_repartition.valid() and processed_requests == install_at) {
+            // the cut update assumes both directions of an edge weigh the
+            // same, which lazily decayed values broke during the lag
+            partition_manager_.apply_decay();
+            partition_manager_.update_partitions(pending_repartition.get());
+            log.register_repartition(partition_manager_);
+            log.register_repartition_lag(log.makespan() - requested_at_time);
+            engine.barrier();
+            engine.run();
+            log.register_migration(
+                partition_manager_.last_migration(), migration_cost_
+            );
+        }
 
         bool should_repartition = repartition_interval_ != 0 and
-            log.processed_requests() % repartition_interval_ == 0;
-        if (should_repartition) {
+            processed_requests % repartition_interval_ == 0;
+        if (should_repartition and repartition_lag_ == 0) {
+            partition_manager_.apply_decay();
             repartition_data(partition_manager_.n_partitions());
             log.register_repartition(partition_manager_);
-            log.sync_all_partitions();
+            engine.barrier();
+            engine.run();
+            log.register_migration(
+                partition_manager_.last_migration(), migration_cost_
+            );
+        } else if (should_repartition and not pending_repartition.valid()) {
+            // repartitions due while another one is pending, be it still
+            // computing or waiting for install_at, are skipped
+            partition_manager_.apply_decay();
+            pending_repartition = std::async(
+                std::launch::async, repartition_job()
+            );
+            install_at = processed_requests + repartition_lag_;
+            requested_at_time = log.makespan();
         }
     }
 
+    // the stream ended before the lag ran out, the cut is never installed
+    // but the job may still be using the manager's partitioner
+    if (pending_repartition.valid()) {
+        pending_repartition.wait();
+        log.register_discarded_repartition();
+    }
+
     return log;
 }
 
-std::unordered_set<int> MinCutManager::get_involved_partitions(
-    const Request& request
+void MinCutManager::get_involved_partitions(
+    const Request& request, PartitionSet& involved_partitions
 ) {
-    std::unordered_set<int> involved_partitions;
+    involved_partitions.clear();
     for (auto value: request) {
-	    if (not partition_manager_.in_scheme(value)) {
-            partition_manager_.allocate_value(value);
-        }
-        auto partition_id = partition_manager_.value_to_partition(value);
-        involved_partitions.insert(partition_id);
+        involved_partitions.insert(partition_manager_.allocate_value(value));
     }
-    return involved_partitions;
 }
 
 
@@ -94,6 +115,26 @@ void MinCutManager::set_repartition_interval(int repartition_interval) {
     repartition_interval_ = repartition_interval;
 }
 
+void MinCutManager::set_repartition_lag(int repartition_lag) {
+    repartition_lag_ = repartition_lag;
+}
+
+void MinCutManager::set_migration_cost(int migration_cost) {
+    migration_cost_ = migration_cost;
+}
+
+void MinCutManager::set_access_model(model::AccessModel access_model) {
+    partition_manager_.set_access_model(access_model);
+}
+
+void MinCutManager::set_decay(int half_life, int min_weight) {
+    partition_manager_.set_decay(half_life, min_weight);
+}
+
+void MinCutManager::set_relabel_partitions(bool relabel_partitions) {
+    partition_manager_.set_relabel_partitions(relabel_partitions);
+}
+
 PartitionManager MinCutManager::partition_manager() {
     return partition_manager_;
 }
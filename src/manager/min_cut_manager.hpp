@@ -1,6 +1,8 @@
 #ifndef WORKLOAD_MIN_CUT_MANAGER_H
 #define WORKLOAD_MIN_CUT_MANAGER_H
 
+#include <functional>
+#include <future>
 #include <metis.h>
 #include <string>
 #include <unordered_map>
@@ -11,7 +13,9 @@
 #include "partition/min_cut.h"
 #include "manager.h"
 #include "partition/partition_manager.h"
+#include "partition/partition_set.h"
 #include "request/random.h"
+#include "simulation/engine.h"
 
 namespace workload {
 
@@ -33,20 +37,37 @@ public:
     void initialize_partitions(int n_partitions);
     ExecutionLog execute_requests();
     virtual void repartition_data(int n_partitions) = 0;
+    // Snapshots what the cut needs and returns a job computing it, so it
+    // can run on another thread while the simulation goes on
+    virtual std::function<std::vector<Partition>()> repartition_job() = 0;
 
     PartitionManager partition_manager();
     void export_data(std::string output_path);
 
     void set_repartition_interval(int repartition_interval);
+    void set_repartition_lag(int repartition_lag);
+    void set_migration_cost(int migration_cost);
+    void set_access_model(model::AccessModel access_model);
+    void set_relabel_partitions(bool relabel_partitions);
+    void set_decay(int half_life, int min_weight);
 
 protected:
-    std::unordered_set<int> get_involved_partitions(const Request& request);
+    void get_involved_partitions(
+        const Request& request, PartitionSet& involved_partitions
+    );
     virtual void update_access_structure(const Request& request) {
         partition_manager_.register_access(request);
     }
 
     int repartition_interval_;
+    // Requests executed with the old partitions while a repartition
+    // computes in background, 0 repartitions synchronously
+    int repartition_lag_{0};
+    // Time a partition spends per value it sends or receives when new
+    // partitions are installed
+    int migration_cost_{0};
     PartitionManager partition_manager_;
+    PartitionSet involved_partitions_;
 };
 
 }
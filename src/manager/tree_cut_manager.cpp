@@ -37,6 +37,14 @@ void TreeCutManager::repartition_data(int n_partitions) {
     partition_manager_.update_partitions(data_partitions);
 }
 
+std::function<std::vector<Partition>()> TreeCutManager::repartition_job() {
+    auto snapshot = std::make_shared<const model::SpanningTree>(access_tree_);
+    auto n_partitions = partition_manager_.n_partitions();
+    return [snapshot, n_partitions]() {
+        return model::spanning_tree_cut(*snapshot, n_partitions);
+    };
+}
+
 void TreeCutManager::update_access_structure(const Request& request) {
     for (auto first_data : request) {
         access_tree_.increase_node_weight(first_data, 1);
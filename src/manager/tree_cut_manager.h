@@ -1,6 +1,8 @@
 #ifndef WORKLOAD_TREE_CUT_MANAGER_H
 #define WORKLOAD_TREE_CUT_MANAGER_H
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "partition/min_cut.h"
@@ -27,6 +29,7 @@ public:
     void initialize_tree();
     const model::SpanningTree& access_tree();
     void repartition_data(int n_partitions);
+    std::function<std::vector<Partition>()> repartition_job();
     void export_data(std::string output_path);
 
 private:
@@ -2,38 +2,29 @@
 
 namespace model {
 
-// Used by refennel to call refennel if it's the first time it partitions
-bool first_repartition = true;
+// METIS and KaHIP keep their random generators in globals, so concurrent
+// multilevel cuts take turns
+std::mutex multilevel_cut_mutex;
 
 std::vector<workload::Partition> multilevel_cut(
     const model::Graph& graph, idx_t n_partitions, CutMethod cut_method
 ) {
-    const auto& vertex = graph.vertex();
-    idx_t n_vertice = vertex.size();
-    idx_t n_constrains = 1;
-
-    auto vertice_weight = std::vector<idx_t>();
-    for (auto i = 0; i < vertex.size(); i++) {
-        vertice_weight.push_back(vertex.at(i));
+    static_assert(
+        std::is_same<idx_t, int>::value,
+        "Graph rows are handed to METIS and KaHIP as is, idx_t must be int"
+    );
+    if (not graph.is_compact()) {
+        auto compacted_graph = graph;
+        compacted_graph.compact();
+        return multilevel_cut(compacted_graph, n_partitions, cut_method);
     }
 
-    auto x_edges = std::vector<idx_t>();
-    auto edges = std::vector<idx_t>();
-    auto edges_weight = std::vector<idx_t>();
-
-    x_edges.push_back(0);
-    for (auto vertice = 0; vertice < vertex.size(); vertice++) {
-        auto last_edge_index = x_edges.back();
-        auto n_neighbours = graph.vertice_edges(vertice).size();
-        x_edges.push_back(last_edge_index + n_neighbours);
-
-        for (const auto& vk: graph.vertice_edges(vertice)) {
-            auto neighbour = vk.first;
-            auto weight = vk.second;
-            edges.push_back(neighbour);
-            edges_weight.push_back(weight);
-        }
-    }
+    idx_t n_vertice = graph.vertex_weights().size();
+    idx_t n_constrains = 1;
+    auto* x_edges = const_cast<idx_t*>(graph.csr_offsets().data());
+    auto* edges = const_cast<idx_t*>(graph.csr_neighbours().data());
+    auto* edges_weight = const_cast<idx_t*>(graph.csr_weights().data());
+    auto* vertice_weight = const_cast<idx_t*>(graph.vertex_weights().data());
 
     idx_t options[METIS_NOPTIONS];
     METIS_SetDefaultOptions(options);
@@ -43,17 +34,18 @@ std::vector<workload::Partition> multilevel_cut(
 
     idx_t objval;
     auto vertex_partitions = std::vector<idx_t>(n_vertice, 0);
+    auto lock = std::lock_guard<std::mutex>(multilevel_cut_mutex);
     if (cut_method == METIS) {
         METIS_PartGraphKway(
-            &n_vertice, &n_constrains, x_edges.data(), edges.data(),
-            vertice_weight.data(), NULL, edges_weight.data(), &n_partitions, NULL,
+            &n_vertice, &n_constrains, x_edges, edges,
+            vertice_weight, NULL, edges_weight, &n_partitions, NULL,
             NULL, options, &objval, vertex_partitions.data()
         );
     } else {
         double imbalance = 0.2;  // equal to METIS default imbalance
         kaffpa(
-            &n_vertice, vertice_weight.data(), x_edges.data(),
-            edges_weight.data(), edges.data(), &n_partitions,
+            &n_vertice, vertice_weight, x_edges,
+            edges_weight, edges, &n_partitions,
             &imbalance, true, -1, FAST, &objval,
             vertex_partitions.data()
         );
@@ -62,6 +54,9 @@ std::vector<workload::Partition> multilevel_cut(
     std::vector<workload::Partition> partitions(n_partitions, workload::Partition());
     for (auto i = 0; i < vertex_partitions.size(); i++) {
         auto vertice = i;
+        if (not graph.exist_vertice(vertice)) {
+            continue;
+        }
         auto vertice_partition = vertex_partitions[vertice];
 
         partitions[vertice_partition].insert(vertice);
@@ -70,26 +65,11 @@ std::vector<workload::Partition> multilevel_cut(
     return partitions;
 }
 
-int fennel_inter_cost(
-    const std::unordered_map<int, int>& edges,
-    const workload::Partition& partition
-) {
-    const auto& vertex = partition.data();
-    auto cost = 0;
-    for (auto& kv : edges) {
-        auto vertice = kv.first;
-        auto weight = kv.second;
-        if (vertex.find(vertice) != vertex.end()) {
-            cost += weight;
-        }
-    }
-    return cost;
-}
-
-int biggest_value_index(std::vector<double>& partitions_score) {
-    auto index = 0;
-    auto biggest = partitions_score[0];
-    for (auto i = 1; i < partitions_score.size(); i++) {
+// First partition with the biggest score, -1 if none is above -DBL_MAX
+int biggest_value_index(const std::vector<double>& partitions_score) {
+    auto index = -1;
+    auto biggest = -DBL_MAX;
+    for (auto i = 0; i < partitions_score.size(); i++) {
         if (partitions_score[i] > biggest) {
             biggest = partitions_score[i];
             index = i;
@@ -98,111 +78,307 @@ int biggest_value_index(std::vector<double>& partitions_score) {
     return index;
 }
 
-int fennel_vertice_partition(
-    const Graph& graph, int vertice, const std::vector<workload::Partition>& partitions,
-    int max_partition_size, double alpha, double gamma
+std::vector<int> vertex_order(
+    const model::Graph& graph,
+    VertexOrder order,
+    unsigned seed /*= 0*/,
+    const std::vector<int>& trace_order /*= {}*/
 ) {
-    double biggest_score = -DBL_MAX;
-    auto id = 0;
-    auto designated_partition = 0;
-    for (const auto& partition : partitions) {
-        auto partition_weight = partition.weight();
-        if (max_partition_size > 0) {
-            if (partition_weight + graph.vertice_weight(vertice) > max_partition_size) {
-                id++;
-                continue;
+    auto vertex = std::vector<int>();
+    vertex.reserve(graph.n_vertex());
+    for (const auto& kv : graph.vertex()) {
+        vertex.push_back(kv.first);
+    }
+
+    if (order == DEGREE) {
+        std::stable_sort(vertex.begin(), vertex.end(), [&](int a, int b) {
+            return graph.vertice_edges(a).size() > graph.vertice_edges(b).size();
+        });
+    } else if (order == RANDOM) {
+        auto generator = std::mt19937(seed);
+        std::shuffle(vertex.begin(), vertex.end(), generator);
+    } else if (order == BFS or order == TRACE) {
+        auto visited = std::vector<bool>(graph.vertex_weights().size(), false);
+        auto ordered = std::vector<int>();
+        ordered.reserve(vertex.size());
+        auto visit = [&](int vertice) {
+            if (graph.exist_vertice(vertice) and not visited[vertice]) {
+                visited[vertice] = true;
+                ordered.push_back(vertice);
+            }
+        };
+
+        if (order == TRACE) {
+            for (auto vertice : trace_order) {
+                visit(vertice);
+            }
+            for (auto vertice : vertex) {
+                visit(vertice);
+            }
+        } else {
+            // ordered doubles as the BFS queue
+            for (auto root : vertex) {
+                auto head = ordered.size();
+                visit(root);
+                for (; head < ordered.size(); head++) {
+                    for (const auto& kv : graph.vertice_edges(ordered[head])) {
+                        visit(kv.first);
+                    }
+                }
             }
         }
+        vertex = std::move(ordered);
+    }
 
-        const auto& edges = graph.vertice_edges(vertice);
+    return vertex;
+}
 
-        auto inter_cost = fennel_inter_cost(edges, partition);
-        auto intra_cost =
-            (std::pow(partition.weight() + graph.vertice_weight(vertice), gamma));
-        intra_cost -= std::pow(partition.weight(), gamma);
-        intra_cost *= alpha;
-        auto score = inter_cost - intra_cost;
+// Streams the vertex in order, passes times, placing each one on the
+// partition with the best FENNEL score. vertice_partition holds the
+// starting partition of each vertex (-1 if not placed) and partitions_weight
+// the matching loads, both are updated. Placed vertex are scored with their
+// weight still in their partition, as REFENNEL always did. Returns how many
+// vertex were placed or moved on each pass.
+//
+// With several threads the vertex are taken in chunks. Placements are
+// published right away through atomics, but each thread only refreshes its
+// copy of the loads every FENNEL_WEIGHT_REFRESH vertex, so the loads it
+// sees are at most that stale. A single thread gives the sequential result.
+std::vector<int> restream_fennel(
+    const Graph& graph,
+    const std::vector<int>& order,
+    const FennelOptions& options,
+    std::vector<int>& vertice_partition,
+    std::vector<int>& partitions_weight
+) {
+    const auto n_partitions = partitions_weight.size();
+    const auto gamma = 3 / 2.0;
+    const auto alpha =
+        graph.total_edges_weight() * std::pow(n_partitions, (gamma - 1)) /
+        std::pow(graph.total_vertex_weight(), gamma);
+    const int max_partition_size = 1.2 * graph.total_vertex_weight() / n_partitions;
 
-        if (score > biggest_score) {
-            biggest_score = score;
-            designated_partition = id;
+    auto shared_partition = std::vector<std::atomic<int>>(vertice_partition.size());
+    for (auto i = 0; i < vertice_partition.size(); i++) {
+        shared_partition[i].store(vertice_partition[i], std::memory_order_relaxed);
+    }
+    auto shared_weight = std::vector<std::atomic<int>>(n_partitions);
+    for (auto i = 0; i < n_partitions; i++) {
+        shared_weight[i].store(partitions_weight[i], std::memory_order_relaxed);
+    }
+
+    const auto n_chunks = (order.size() + FENNEL_CHUNK_SIZE - 1) / FENNEL_CHUNK_SIZE;
+    const auto n_threads = std::max(1, std::min<int>(options.n_threads, n_chunks));
+    auto next_chunk = std::atomic<std::size_t>(0);
+    auto pass_moves = std::atomic<int>(0);
+
+    auto stream = [&]() {
+        auto weight = std::vector<int>(n_partitions);
+        auto partitions_score = std::vector<double>(n_partitions);
+        auto since_refresh = FENNEL_WEIGHT_REFRESH;
+        auto moves = 0;
+
+        while (true) {
+            auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= n_chunks) {
+                pass_moves.fetch_add(moves, std::memory_order_relaxed);
+                return;
+            }
+            auto end = std::min(order.size(), (chunk + 1) * FENNEL_CHUNK_SIZE);
+            for (auto i = chunk * FENNEL_CHUNK_SIZE; i < end; i++) {
+                if (since_refresh == FENNEL_WEIGHT_REFRESH) {
+                    for (auto p = 0; p < n_partitions; p++) {
+                        weight[p] = shared_weight[p].load(std::memory_order_relaxed);
+                    }
+                    since_refresh = 0;
+                }
+                since_refresh++;
+
+                auto vertice = order[i];
+                auto vertice_weight = graph.vertice_weight(vertice);
+                auto old_partition = shared_partition[vertice].load(
+                    std::memory_order_relaxed
+                );
+                std::fill(partitions_score.begin(), partitions_score.end(), 0);
+                if (old_partition != -1) {
+                    partitions_score[old_partition] += options.migration_penalty;
+                }
+                for (const auto& kv : graph.vertice_edges(vertice)) {
+                    auto partition = shared_partition[kv.first].load(
+                        std::memory_order_relaxed
+                    );
+                    if (partition != -1) {
+                        partitions_score[partition] += kv.second;
+                    }
+                }
+                for (auto p = 0; p < n_partitions; p++) {
+                    if (max_partition_size > 0 and
+                        weight[p] + vertice_weight > max_partition_size)
+                    {
+                        partitions_score[p] = -INFINITY;
+                        continue;
+                    }
+                    partitions_score[p] -= alpha * (
+                        std::pow(weight[p] + vertice_weight, gamma) -
+                        std::pow(weight[p], gamma)
+                    );
+                }
+                auto new_partition = biggest_value_index(partitions_score);
+                if (new_partition == -1) {
+                    // every partition is full, as in hypergraph_fennel_cut
+                    new_partition = std::min_element(
+                        weight.begin(), weight.end()
+                    ) - weight.begin();
+                }
+
+                if (new_partition != old_partition) {
+                    moves++;
+                }
+                if (old_partition != -1) {
+                    weight[old_partition] -= vertice_weight;
+                    shared_weight[old_partition].fetch_sub(
+                        vertice_weight, std::memory_order_relaxed
+                    );
+                }
+                weight[new_partition] += vertice_weight;
+                shared_weight[new_partition].fetch_add(
+                    vertice_weight, std::memory_order_relaxed
+                );
+                shared_partition[vertice].store(
+                    new_partition, std::memory_order_relaxed
+                );
+            }
+        }
+    };
+
+    auto moves = std::vector<int>();
+    for (auto pass = 0; pass < options.passes; pass++) {
+        next_chunk.store(0);
+        pass_moves.store(0);
+        auto workers = std::vector<std::thread>();
+        for (auto i = 1; i < n_threads; i++) {
+            workers.emplace_back(stream);
         }
-        id++;
+        stream();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        moves.push_back(pass_moves.load());
     }
 
-    return designated_partition;
+    for (auto i = 0; i < vertice_partition.size(); i++) {
+        vertice_partition[i] = shared_partition[i].load(std::memory_order_relaxed);
+    }
+    for (auto i = 0; i < n_partitions; i++) {
+        partitions_weight[i] = shared_weight[i].load(std::memory_order_relaxed);
+    }
+    return moves;
 }
 
 std::vector<workload::Partition> fennel_cut(
-    const model::Graph& graph, size_t n_partitions
+    const model::Graph& graph,
+    size_t n_partitions,
+    const FennelOptions& options /*= FennelOptions()*/,
+    const std::vector<int>& trace_order /*= {}*/
 ) {
-    std::vector<workload::Partition> partitions(n_partitions, workload::Partition());
+    auto vertice_partition = std::vector<int>(graph.vertex_weights().size(), -1);
+    auto partitions_weight = std::vector<int>(n_partitions, 0);
+    restream_fennel(
+        graph,
+        vertex_order(graph, options.order, options.seed, trace_order),
+        options,
+        vertice_partition,
+        partitions_weight
+    );
 
-    const auto edges_weight = graph.total_edges_weight();
-    const auto vertex_weight = graph.total_vertex_weight();
-    const auto gamma = 3 / 2.0;
-    const auto alpha =
-        edges_weight * std::pow(partitions.size(), (gamma - 1)) / std::pow(graph.total_vertex_weight(), gamma);
-    auto partition_max_size = 1.2 * graph.total_vertex_weight() / n_partitions;
-    for (const auto& kv: graph.vertex()) {
-        auto vertice = kv.first;
-        auto partition = fennel_vertice_partition(
-            graph, vertice, partitions,
-            partition_max_size, alpha, gamma
-        );
-        if (partition == -1) {
-            partition_max_size = 0;
-            partition = fennel_vertice_partition(
-                graph, vertice, partitions,
-                partition_max_size, alpha, gamma
-            );
-        }
-        partitions[partition].insert(vertice, graph.vertice_weight(vertice));
+    std::vector<workload::Partition> partitions(n_partitions, workload::Partition());
+    for (const auto& kv : graph.vertex()) {
+        partitions[vertice_partition[kv.first]].insert(kv.first, kv.second);
     }
-
     return partitions;
 }
 
-std::vector<workload::Partition> refennel_cut(
-    workload::PartitionManager& partition_scheme
+// FENNEL streaming over a hypergraph: a vertex gains the weight of every
+// net already present in a partition, since joining it doesn't increase
+// that net's connectivity
+std::vector<workload::Partition> hypergraph_fennel_cut(
+    const model::Hypergraph& hypergraph, int n_partitions
 ) {
-    if (first_repartition) {
-        first_repartition = false;
-        return fennel_cut(
-            partition_scheme.access_graph(), partition_scheme.n_partitions()
-        );
-    }
-    auto n_partitions = partition_scheme.n_partitions();
-    const auto& graph = partition_scheme.access_graph();
+    auto vertice_offsets = std::vector<int>();
+    auto vertice_nets = std::vector<int>();
+    hypergraph.incident_nets(vertice_offsets, vertice_nets);
+
+    const auto n_words = (n_partitions + 63) / 64;
+    auto net_partitions = std::vector<std::uint64_t>(
+        hypergraph.n_nets() * n_words, 0
+    );
+    auto partitions_weight = std::vector<int>(n_partitions, 0);
+    auto partitions_score = std::vector<double>(n_partitions, 0);
+    std::vector<workload::Partition> partitions(n_partitions, workload::Partition());
 
-    const auto& edges_weight = graph.total_edges_weight();
-    const auto& vertex_weight = graph.total_vertex_weight();
     const auto gamma = 3 / 2.0;
     const auto alpha =
-        edges_weight * std::pow(partition_scheme.n_partitions(), (gamma - 1)) / std::pow(graph.total_vertex_weight(), gamma);
-    auto partition_max_size = 1.2 * graph.total_vertex_weight() / partition_scheme.n_partitions();
-    for (auto& kv: graph.vertex()) {
+        hypergraph.total_nets_weight() * std::pow(n_partitions, (gamma - 1)) /
+        std::pow(hypergraph.total_vertex_weight(), gamma);
+    const auto partition_max_size =
+        1.2 * hypergraph.total_vertex_weight() / n_partitions;
+    for (const auto& kv : hypergraph.vertex()) {
         auto vertice = kv.first;
-        auto new_partition = fennel_vertice_partition(
-            graph, vertice, partition_scheme.partitions(),
-            partition_max_size, alpha, gamma
-        );
-        if (new_partition == -1) {
-            partition_max_size = 0;
-            new_partition = fennel_vertice_partition(
-                graph, vertice, partition_scheme.partitions(),
-                partition_max_size, alpha, gamma
+        auto weight = kv.second;
+
+        std::fill(partitions_score.begin(), partitions_score.end(), 0);
+        for (auto i = vertice_offsets[vertice]; i < vertice_offsets[vertice+1]; i++) {
+            auto net = vertice_nets[i];
+            auto net_weight = hypergraph.net_weight(net);
+            for (auto word = 0; word < n_words; word++) {
+                auto bits = net_partitions[net * n_words + word];
+                while (bits != 0) {
+                    partitions_score[word * 64 + __builtin_ctzll(bits)] += net_weight;
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        auto designated_partition = -1;
+        auto biggest_score = -DBL_MAX;
+        for (auto partition = 0; partition < n_partitions; partition++) {
+            auto partition_weight = partitions_weight[partition];
+            if (partition_weight + weight > partition_max_size) {
+                continue;
+            }
+            auto intra_cost = alpha * (
+                std::pow(partition_weight + weight, gamma) -
+                std::pow(partition_weight, gamma)
             );
+            auto score = partitions_score[partition] - intra_cost;
+            if (score > biggest_score) {
+                biggest_score = score;
+                designated_partition = partition;
+            }
+        }
+        if (designated_partition == -1) {
+            designated_partition = std::min_element(
+                partitions_weight.begin(), partitions_weight.end()
+            ) - partitions_weight.begin();
         }
-        partition_scheme.remove_value(vertice);
-        partition_scheme.add_value(vertice, new_partition, graph.vertice_weight(vertice));
-    }
 
-    return partition_scheme.partitions();
+        partitions_weight[designated_partition] += weight;
+        partitions[designated_partition].insert(vertice, weight);
+        auto word = designated_partition / 64;
+        auto bit = std::uint64_t(1) << (designated_partition % 64);
+        for (auto i = vertice_offsets[vertice]; i < vertice_offsets[vertice+1]; i++) {
+            net_partitions[vertice_nets[i] * n_words + word] |= bit;
+        }
+    }
 
+    return partitions;
 }
 
-std::vector<workload::Partition> spanning_tree_cut(SpanningTree tree, int n_partitions) {
+// Nodes are placed whole, heaviest edge to parent per unit of weight
+// last. The tree is only read, so a snapshot can be cut as is.
+std::vector<workload::Partition> spanning_tree_cut(
+    const SpanningTree& tree, int n_partitions
+) {
     auto partitions = std::vector<workload::Partition>();
     for (auto i = 0; i < n_partitions-1; i++) {
         auto partition = workload::Partition();
@@ -212,16 +388,14 @@ std::vector<workload::Partition> spanning_tree_cut(SpanningTree tree, int n_part
     auto detatched_ids = std::vector<std::pair<double, int>>();
     auto nodes = std::vector<std::pair<int, int>>();
 
-    for (auto& kv : tree.vertex()) {
-        auto vertice = kv.first;
-        auto weight = kv.second;
+    for (auto vertice = 0; vertice < tree.n_ids(); vertice++) {
+        auto weight = tree.vertice_weight(vertice);
 
         if (tree.is_detatched(vertice)) {
             auto p = std::make_pair(weight, vertice);
             detatched_ids.push_back(p);
         } else if (not tree.is_inside_node(vertice)) {
-            auto parent = tree.parent(vertice);
-            auto cost = (double) tree.edge_weight(vertice, parent) / weight;
+            auto cost = (double) tree.parent_edge_weight(vertice) / weight;
             auto p = std::make_pair(cost, vertice);
             nodes.push_back(p);
         }
@@ -243,12 +417,11 @@ std::vector<workload::Partition> spanning_tree_cut(SpanningTree tree, int n_part
                 continue;
             }
             if (partition.weight() + tree.vertice_weight(node) < max_weight) {
-                for (auto id : tree.ids_in_node(node)) {
+                tree.for_each_id_in_node(node, [&](int id) {
                     partition.insert(id);
-                }
+                });
                 partition.increase_weight(node, tree.vertice_weight(node));
                 used_ids.insert(node);
-                tree.unpropagate_weight(node);
             }
             if (partition.weight() >= min_weight) {
                 break;
@@ -278,12 +451,11 @@ std::vector<workload::Partition> spanning_tree_cut(SpanningTree tree, int n_part
             continue;
         }
 
-        for (auto id : tree.ids_in_node(node)) {
+        tree.for_each_id_in_node(node, [&](int id) {
             final_partition.insert(id);
-        }
+        });
         final_partition.increase_weight(node, tree.vertice_weight(node));
         used_ids.insert(node);
-        tree.unpropagate_weight(node);
     }
     for (auto& kv : detatched_ids) {
         auto id = kv.second;
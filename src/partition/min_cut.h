@@ -2,10 +2,17 @@
 #define MODEL_MIN_CUT_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <float.h>
 #include <fstream>
 #include <math.h>
+#include <mutex>
+#include <queue>
+#include <random>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -15,32 +22,78 @@
 #include "metis.h"
 
 #include "graph/graph.h"
+#include "graph/hypergraph.h"
 #include "graph/spanning_tree.h"
 #include "partition/partition.h"
 #include "partition/partition_manager.h"
 
 namespace model {
 
-enum CutMethod {METIS, KAHIP, FENNEL, REFENNEL};
+enum CutMethod {METIS, KAHIP, FENNEL, REFENNEL, HYPERGRAPH_FENNEL};
 const std::unordered_map<std::string, CutMethod> string_to_cut_method({
     {"METIS", METIS},
     {"KAHIP", KAHIP},
     {"FENNEL", FENNEL},
-    {"REFENNEL", REFENNEL}
+    {"REFENNEL", REFENNEL},
+    {"HYPERGRAPH_FENNEL", HYPERGRAPH_FENNEL}
 });
 const double MAX_IMBALANCE = 1.03;
 
+// Order FENNEL streams the vertex in: by id, breadth first, by descending
+// degree, shuffled, or by first access in the trace
+enum VertexOrder {ID, BFS, DEGREE, RANDOM, TRACE};
+const std::unordered_map<std::string, VertexOrder> string_to_vertex_order({
+    {"ID", ID},
+    {"BFS", BFS},
+    {"DEGREE", DEGREE},
+    {"RANDOM", RANDOM},
+    {"TRACE", TRACE}
+});
+
+// Vertex are streamed in chunks of this size, each thread refreshing its
+// view of the partitions weight at least once per chunk
+const int FENNEL_CHUNK_SIZE = 1024;
+const int FENNEL_WEIGHT_REFRESH = 64;
+
+struct FennelOptions {
+    int passes = 1;
+    VertexOrder order = ID;
+    unsigned seed = 0;
+    int n_threads = 1;
+    // Score a vertex gets for staying in the partition it already is in,
+    // trading cut quality for fewer migrated values
+    double migration_penalty = 0;
+};
+
 std::vector<workload::Partition> multilevel_cut(
     const model::Graph& graph, idx_t n_partitions, CutMethod cut_method
 );
+std::vector<int> vertex_order(
+    const model::Graph& graph,
+    VertexOrder order,
+    unsigned seed = 0,
+    const std::vector<int>& trace_order = {}
+);
+std::vector<int> restream_fennel(
+    const model::Graph& graph,
+    const std::vector<int>& order,
+    const FennelOptions& options,
+    std::vector<int>& vertice_partition,
+    std::vector<int>& partitions_weight
+);
 std::vector<workload::Partition> fennel_cut(
-    const model::Graph& graph, size_t n_partitions
+    const model::Graph& graph,
+    size_t n_partitions,
+    const FennelOptions& options = FennelOptions(),
+    const std::vector<int>& trace_order = {}
 );
-std::vector<workload::Partition> refennel_cut(
-    workload::PartitionManager& partition_manager
+std::vector<workload::Partition> hypergraph_fennel_cut(
+    const model::Hypergraph& hypergraph, int n_partitions
 );
 
-std::vector<workload::Partition> spanning_tree_cut(SpanningTree tree, int n_partitions);
+std::vector<workload::Partition> spanning_tree_cut(
+    const SpanningTree& tree, int n_partitions
+);
 
 }
 
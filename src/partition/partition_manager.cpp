@@ -2,12 +2,30 @@
 
 namespace workload {
 
+int n_dense_values(const std::vector<int>& values) {
+    auto max_value = -1;
+    for (auto value : values) {
+        max_value = std::max(max_value, value);
+    }
+    return max_value + 1;
+}
+
+void check_n_partitions(int n_partitions) {
+    if (n_partitions > MAX_PARTITIONS) {
+        throw std::invalid_argument(
+            "at most " + std::to_string(MAX_PARTITIONS) + " partitions"
+        );
+    }
+}
+
 PartitionManager::PartitionManager(
     int n_partitions,
     const std::vector<int>& values
 ) : round_robin_counter_{0},
-    access_graph_{model::Graph()} {
+    access_graph_{model::Graph()},
+    value_to_partition_{PartitionTable(n_dense_values(values))} {
 
+    check_n_partitions(n_partitions);
     partitions_ = std::vector<Partition>(n_partitions);
     for (const auto& value: values) {
         allocate_value(value);
@@ -19,62 +37,332 @@ PartitionManager::PartitionManager(
     std::vector<Partition>& partitions
 ) : partitions_{partitions}
 {
+    check_n_partitions(partitions.size());
+    auto values = std::vector<int>();
+    for (const auto& partition : partitions) {
+        values.insert(values.end(), partition.data().begin(), partition.data().end());
+    }
+    value_to_partition_ = PartitionTable(n_dense_values(values));
     update_partitions(partitions);
 }
 
 void PartitionManager::update_partitions(
     const std::vector<Partition>& partitions
 ) {
+    auto labels = partition_labels(partitions);
     partitions_ = std::vector<Partition>(partitions.size(), Partition());
-    value_to_partition_ = std::unordered_map<int, int>();
+    auto previous_partition = std::move(value_to_partition_);
+    value_to_partition_ = PartitionTable(previous_partition.n_dense_values());
 
     for (auto i = 0; i < partitions.size(); i++) {
         const auto& partition = partitions.at(i);
+        auto label = labels[i];
         for (auto value: partition.data()) {
-            auto value_weight = access_graph_.vertice_weight(value);
-            partitions_[i].insert(value, value_weight);
-            value_to_partition_.insert(std::make_pair(value, i));
+            auto value_weight = this->value_weight(value);
+            partitions_[label].insert(value, value_weight);
+            value_to_partition_.set(value, label);
         }
     }
+    // A cut computed on a snapshot misses the values first allocated after
+    // it, those stay where they are
+    previous_partition.for_each([&](int value, int partition) {
+        if (not value_to_partition_.contains(value)) {
+            partitions_[partition].insert(value, value_weight(value));
+            value_to_partition_.set(value, partition);
+        }
+    });
+    update_cut_value(previous_partition);
+    register_migration(previous_partition);
+}
+
+// Values getting a partition for the first time don't count as moved
+void PartitionManager::register_migration(
+    const PartitionTable& previous_partition
+) {
+    last_migration_.moved_values = 0;
+    last_migration_.sent_values.assign(partitions_.size(), 0);
+    last_migration_.received_values.assign(partitions_.size(), 0);
+    value_to_partition_.for_each([&](int value, int partition) {
+        auto previous = previous_partition.get(value);
+        if (previous != -1 and previous != partition) {
+            last_migration_.moved_values++;
+            last_migration_.sent_values[previous]++;
+            last_migration_.received_values[partition]++;
+        }
+    });
+}
+
+// Hungarian algorithm over an n x n row-major weight matrix, returning the
+// column matched to every row so the total weight is the largest. O(n^3).
+std::vector<int> max_weight_matching(const std::vector<int>& weights, int n) {
+    const auto infinity = std::numeric_limits<long long>::max();
+    // Potentials and matches are 1-indexed, column 0 being a sentinel
+    auto row_potential = std::vector<long long>(n + 1, 0);
+    auto column_potential = std::vector<long long>(n + 1, 0);
+    auto column_match = std::vector<int>(n + 1, 0);
+    auto previous_column = std::vector<int>(n + 1, 0);
+    auto min_slack = std::vector<long long>(n + 1);
+    auto used = std::vector<bool>(n + 1);
+
+    for (auto row = 1; row <= n; row++) {
+        column_match[0] = row;
+        auto column = 0;
+        std::fill(min_slack.begin(), min_slack.end(), infinity);
+        std::fill(used.begin(), used.end(), false);
+        do {
+            used[column] = true;
+            auto matched_row = column_match[column];
+            auto delta = infinity;
+            auto next_column = 0;
+            for (auto j = 1; j <= n; j++) {
+                if (used[j]) {
+                    continue;
+                }
+                auto cost = -(long long) weights[(matched_row - 1) * n + j - 1];
+                auto slack = cost - row_potential[matched_row] - column_potential[j];
+                if (slack < min_slack[j]) {
+                    min_slack[j] = slack;
+                    previous_column[j] = column;
+                }
+                if (min_slack[j] < delta) {
+                    delta = min_slack[j];
+                    next_column = j;
+                }
+            }
+            for (auto j = 0; j <= n; j++) {
+                if (used[j]) {
+                    row_potential[column_match[j]] += delta;
+                    column_potential[j] -= delta;
+                } else {
+                    min_slack[j] -= delta;
+                }
+            }
+            column = next_column;
+        } while (column_match[column] != 0);
+        do {
+            auto previous = previous_column[column];
+            column_match[column] = column_match[previous];
+            column = previous;
+        } while (column != 0);
+    }
+
+    auto row_match = std::vector<int>(n);
+    for (auto j = 1; j <= n; j++) {
+        row_match[column_match[j] - 1] = j - 1;
+    }
+    return row_match;
+}
+
+// Label each new partition takes: the current partition it shares the most
+// values with, as a whole matching. The overlap matrix comes from a single
+// lookup per value.
+std::vector<int> PartitionManager::partition_labels(
+    const std::vector<Partition>& partitions
+) const {
+    const int n = partitions.size();
+    auto labels = std::vector<int>(n);
+    std::iota(labels.begin(), labels.end(), 0);
+    if (not relabel_partitions_ or n != partitions_.size()) {
+        return labels;
+    }
+
+    auto overlap = std::vector<int>(n * n, 0);
+    auto total_overlap = 0;
+    for (auto i = 0; i < n; i++) {
+        for (auto value : partitions[i].data()) {
+            auto previous = value_to_partition_.get(value);
+            if (previous != -1) {
+                overlap[i * n + previous]++;
+                total_overlap++;
+            }
+        }
+    }
+    if (total_overlap == 0) {
+        return labels;
+    }
+    return max_weight_matching(overlap, n);
+}
+
+bool is_cut(int partition, int other_partition) {
+    return partition != -1 and other_partition != -1 and
+        partition != other_partition;
+}
+
+// Only the edges of values that changed partition can change the cut. An
+// edge between two moved values is seen from both of them, one between a
+// moved value and a still one only from the former, so it's counted twice.
+void PartitionManager::update_cut_value(
+    const PartitionTable& previous_partition
+) {
+    if (access_model_ != model::CLIQUE) {
+        return;
+    }
+
+    auto moved = [&](int value) {
+        return previous_partition.get(value) != value_to_partition_.get(value);
+    };
+    auto update_edges = [&](int value) {
+        if (not access_graph_.exist_vertice(value)) {
+            return;
+        }
+        for (const auto& kv : access_graph_.vertice_edges(value)) {
+            auto neighbour = kv.first;
+            auto weight = kv.second;
+            auto was_cut = is_cut(
+                previous_partition.get(value), previous_partition.get(neighbour)
+            );
+            auto now_cut = is_cut(
+                value_to_partition_.get(value), value_to_partition_.get(neighbour)
+            );
+            auto ends = moved(neighbour) ? 1 : 2;
+            cut_value_ += ends * weight * (now_cut - was_cut);
+        }
+    };
+
+    value_to_partition_.for_each([&](int value, int) {
+        if (moved(value)) {
+            update_edges(value);
+        }
+    });
+}
+
+// Cut change of value going from one partition to another, -1 standing
+// for out of the scheme. Must be called before value_to_partition_ changes.
+void PartitionManager::move_cut_value(int value, int from, int to) {
+    if (access_model_ != model::CLIQUE or not access_graph_.exist_vertice(value)) {
+        return;
+    }
+    for (const auto& kv : access_graph_.vertice_edges(value)) {
+        auto partition = value_to_partition_.get(kv.first);
+        auto weight = kv.second;
+        cut_value_ += 2 * weight * (is_cut(to, partition) - is_cut(from, partition));
+    }
 }
 
 int PartitionManager::allocate_value(int value) {
-    if (value_to_partition_.find(value) != value_to_partition_.end()) {
-        return value_to_partition_.at(value);
+    auto partition = value_to_partition_.get(value);
+    if (partition != -1) {
+        return partition;
     }
 
     auto partition_id = round_robin_counter_;
     round_robin_counter_ = (round_robin_counter_ + 1) % partitions_.size();
     partitions_.at(partition_id).insert(value);
-    value_to_partition_.insert(std::make_pair(value, partition_id));
+    value_to_partition_.set(value, partition_id);
 
     return partition_id;
 }
 
 void PartitionManager::add_value(int value, int partition, int n_accesses) {
+    move_cut_value(value, value_to_partition_.get(value), partition);
     partitions_[partition].insert(value, n_accesses);
-    value_to_partition_[value] = partition;
+    value_to_partition_.set(value, partition);
 }
 
 void PartitionManager::register_access(
-    const std::unordered_set<int>& involved_values
+    const workload::Request& involved_values
 ) {
+    // values are placed first, so the cut of their new edges is known
+    for (auto value : involved_values) {
+        allocate_value(value);
+    }
+    if (decay_half_life_ != 0 and access_model_ == model::CLIQUE) {
+        for (auto value : involved_values) {
+            decay_value(value);
+        }
+        n_accesses_++;
+    }
     update_graph(involved_values);
     update_partition(involved_values);
+
+    for (auto value : involved_values) {
+        if (value >= accessed_.size()) {
+            accessed_.resize(value + 1, false);
+        }
+        if (not accessed_[value]) {
+            accessed_[value] = true;
+            access_order_.push_back(value);
+        }
+    }
+}
+
+void PartitionManager::set_decay(int half_life, int min_weight /*= 1*/) {
+    decay_half_life_ = half_life;
+    decay_min_weight_ = min_weight;
+}
+
+// Edges only gain weight along with both their ends, so a value's out
+// edges can all share its epoch
+void PartitionManager::decay_value(int value) {
+    auto epoch = static_cast<int>(n_accesses_ / decay_half_life_);
+    if (value >= decay_epoch_.size()) {
+        decay_epoch_.resize(value + 1, 0);
+    }
+    auto halvings = epoch - decay_epoch_[value];
+    decay_epoch_[value] = epoch;
+    if (halvings == 0 or not access_graph_.exist_vertice(value)) {
+        return;
+    }
+
+    auto partition = value_to_partition_.get(value);
+    for (const auto& kv : access_graph_.vertice_edges(value)) {
+        auto weight = kv.second;
+        auto decayed_weight = weight >> std::min(halvings, 31);
+        if (decayed_weight < decay_min_weight_) {
+            decayed_weight = 0;
+        }
+        if (is_cut(partition, value_to_partition_.get(kv.first))) {
+            cut_value_ -= weight - decayed_weight;
+        }
+    }
+    access_graph_.decay_vertice(value, halvings, decay_min_weight_);
+}
+
+void PartitionManager::apply_decay() {
+    if (decay_half_life_ == 0 or access_model_ != model::CLIQUE) {
+        return;
+    }
+    for (const auto& kv : access_graph_.vertex()) {
+        decay_value(kv.first);
+    }
+}
+
+void PartitionManager::set_relabel_partitions(bool relabel_partitions) {
+    relabel_partitions_ = relabel_partitions;
+}
+
+void PartitionManager::set_access_model(model::AccessModel access_model) {
+    if (access_model == model::HYPERGRAPH and access_model_ != model::HYPERGRAPH) {
+        access_hypergraph_ = model::Hypergraph();
+        for (const auto& kv : access_graph_.vertex()) {
+            access_hypergraph_.add_vertice(kv.first, kv.second);
+        }
+    }
+    access_model_ = access_model;
 }
 
 void PartitionManager::update_graph(
-    const std::unordered_set<int>& involved_values
+    const workload::Request& involved_values
 ) {
-    auto auxiliary_set = involved_values;
-    for (auto value: involved_values) {
-        auxiliary_set.erase(value);
+    if (access_model_ == model::HYPERGRAPH) {
+        for (auto value: involved_values) {
+            access_hypergraph_.increase_vertice_weight(value);
+        }
+        access_hypergraph_.add_net(
+            std::vector<int>(involved_values.begin(), involved_values.end())
+        );
+        return;
+    }
+
+    for (auto it = involved_values.begin(); it != involved_values.end(); it++) {
+        auto value = *it;
         if (not access_graph_.exist_vertice(value)) {
             access_graph_.add_vertice(value);
         }
         access_graph_.increase_vertice_weight(value);
 
-        for (auto joint_accessed_value: auxiliary_set) {
+        for (auto joint_it = it + 1; joint_it != involved_values.end(); joint_it++) {
+            auto joint_accessed_value = *joint_it;
             if (not access_graph_.exist_vertice(joint_accessed_value)) {
                 access_graph_.add_vertice(joint_accessed_value);
             }
@@ -87,18 +375,20 @@ void PartitionManager::update_graph(
 
             access_graph_.increase_edge_weight(value, joint_accessed_value);
             access_graph_.increase_edge_weight(joint_accessed_value, value);
+            if (value_to_partition_.at(value) !=
+                value_to_partition_.at(joint_accessed_value))
+            {
+                cut_value_ += 2;
+            }
         }
     }
 }
 
 void PartitionManager::update_partition(
-    const std::unordered_set<int>& involved_values
+    const workload::Request& involved_values
 ) {
     for (auto value: involved_values) {
-        if (value_to_partition_.find(value) == value_to_partition_.end()) {
-            allocate_value(value);
-        }
-        auto partition_id = value_to_partition_.at(value);
+        auto partition_id = allocate_value(value);
         partitions_.at(partition_id).increase_weight(value, 1);
     }
 }
@@ -111,12 +401,13 @@ void PartitionManager::increase_partition_weight(
 
 void PartitionManager::remove_value(int value) {
     auto values_partition = value_to_partition_.at(value);
+    move_cut_value(value, values_partition, -1);
     partitions_.at(values_partition).remove(value);
     value_to_partition_.erase(value);
 }
 
 bool PartitionManager::in_scheme(int value) const {
-    return value_to_partition_.find(value) != value_to_partition_.end();
+    return value_to_partition_.contains(value);
 }
 
 int PartitionManager::n_partitions() const {
@@ -127,12 +418,26 @@ int PartitionManager::value_to_partition(int value) const {
     return value_to_partition_.at(value);
 }
 
+int PartitionManager::value_weight(int value) const {
+    if (access_model_ == model::HYPERGRAPH) {
+        return access_hypergraph_.vertice_weight(value);
+    }
+    return access_graph_.vertice_weight(value);
+}
+
+model::AccessModel PartitionManager::access_model() const {
+    return access_model_;
+}
+
 const std::vector<Partition>& PartitionManager::partitions() const {
     return partitions_;
 }
 
-const std::unordered_map<int, int>&
-PartitionManager::value_to_partition_map() const {
+std::unordered_map<int, int> PartitionManager::value_to_partition_map() const {
+    return value_to_partition_.to_map();
+}
+
+const PartitionTable& PartitionManager::partition_table() const {
     return value_to_partition_;
 }
 
@@ -140,6 +445,52 @@ const model::Graph& PartitionManager::access_graph() const {
     return access_graph_;
 }
 
+// Folds the edges recorded since the last call into the access graph
+// CSR rows, which multilevel_cut then hands to METIS/KaHIP without copying.
+// With the hypergraph access model the clique expansion is only built
+// here, on demand.
+const model::Graph& PartitionManager::compacted_access_graph() {
+    if (access_model_ == model::HYPERGRAPH) {
+        access_graph_ = access_hypergraph_.clique_projection();
+    } else if (not access_graph_.is_compact()) {
+        access_graph_.compact();
+    }
+    return access_graph_;
+}
+
+const std::vector<int>& PartitionManager::access_order() const {
+    return access_order_;
+}
+
+const model::Hypergraph& PartitionManager::access_hypergraph() const {
+    return access_hypergraph_;
+}
+
+int PartitionManager::cut_value() const {
+    return cut_value_;
+}
+
+double PartitionManager::unbalance() const {
+    auto total_weight = 0;
+    for (const auto& partition: partitions_) {
+        total_weight += partition.weight();
+    }
+    auto ideal_partition_weight = (double) total_weight / partitions_.size();
+
+    auto biggest_unbalance = 0;
+    for (const auto& partition: partitions_) {
+        auto partition_weight = partition.weight();
+        if (abs(partition_weight - ideal_partition_weight) > biggest_unbalance) {
+            biggest_unbalance = partition_weight - ideal_partition_weight;
+        }
+    }
+    auto unbalance_percentage = 100*biggest_unbalance/ideal_partition_weight;
+    if (unbalance_percentage < 0) {
+        unbalance_percentage *= -1;
+    }
+    return unbalance_percentage;
+}
+
 model::Graph PartitionManager::graph_representation() const {
     auto graph = model::Graph();
 
@@ -160,4 +511,8 @@ model::Graph PartitionManager::graph_representation() const {
     return graph;
 }
 
+const Migration& PartitionManager::last_migration() const {
+    return last_migration_;
+}
+
 }
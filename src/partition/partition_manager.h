@@ -1,16 +1,33 @@
 #ifndef MODEL_PARTITION_SCHEME_H
 #define MODEL_PARTITION_SCHEME_H
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph/graph.h"
+#include "graph/hypergraph.h"
+#include "request/request.h"
 #include "partition.h"
+#include "partition_set.h"
+#include "partition_table.h"
 
 namespace workload{
 
+// Values that changed partition on the last repartition, counted per
+// partition they left and per partition they joined
+struct Migration {
+    int moved_values = 0;
+    std::vector<int> sent_values;
+    std::vector<int> received_values;
+};
+
 class PartitionManager {
 public:
     PartitionManager() = default;
@@ -21,28 +38,75 @@ public:
 
     int allocate_value(int value);
     void add_value(int value, int partition, int n_accesses);
-    void register_access(const std::unordered_set<int>& involved_values);
+    void register_access(const workload::Request& involved_values);
     void increase_partition_weight(int partition_id, int weight=1);
     void remove_value(int value);
     void update_partitions(const std::vector<Partition>& partitions);
+    void set_access_model(model::AccessModel access_model);
+    // New partitions are renumbered to overlap the current ones as much as
+    // possible, so an unchanged cut moves nothing whatever its numbering
+    void set_relabel_partitions(bool relabel_partitions);
+    // Access graph weights halve every half_life accesses and edges lighter
+    // than min_weight are dropped; a half_life of 0 keeps every access
+    void set_decay(int half_life, int min_weight = 1);
+    // Brings every weight up to date with the decay, which otherwise only
+    // happens to the values being accessed. Called once per cut, so both
+    // directions of every edge hold the same weight for METIS and KaHIP.
+    void apply_decay();
     bool in_scheme(int value) const;
 
     int n_partitions() const;
     int value_to_partition(int value) const;
+    int value_weight(int value) const;
+    model::AccessModel access_model() const;
     const std::vector<Partition>& partitions() const;
-    const std::unordered_map<int, int>& value_to_partition_map() const;
+    std::unordered_map<int, int> value_to_partition_map() const;
+    const PartitionTable& partition_table() const;
     const model::Graph& access_graph() const;
+    const model::Graph& compacted_access_graph();
+    const model::Hypergraph& access_hypergraph() const;
+    // Weight of the access graph edges between partitions, counted from
+    // both ends. Kept up to date as accesses and moves happen, only with
+    // the clique access model.
+    int cut_value() const;
+    // Biggest deviation of a partition weight from the ideal one, as a
+    // percentage of the ideal
+    double unbalance() const;
+    // Values in the order they were first accessed
+    const std::vector<int>& access_order() const;
     model::Graph graph_representation() const;
+    const Migration& last_migration() const;
 
 private:
     int round_robin_counter_{0};
 
-    void update_graph(const std::unordered_set<int>& involved_values);
-    void update_partition(const std::unordered_set<int>& involved_values);
+    void update_graph(const workload::Request& involved_values);
+    void update_partition(const workload::Request& involved_values);
+    void update_cut_value(const PartitionTable& previous_partition);
+    void move_cut_value(int value, int from, int to);
+    void register_migration(const PartitionTable& previous_partition);
+    void decay_value(int value);
+    std::vector<int> partition_labels(
+        const std::vector<Partition>& partitions
+    ) const;
 
+    model::AccessModel access_model_{model::CLIQUE};
     model::Graph access_graph_;
-    std::unordered_map<int, int> value_to_partition_;
+    model::Hypergraph access_hypergraph_;
+    PartitionTable value_to_partition_;
     std::vector<Partition> partitions_;
+    std::vector<int> access_order_;
+    std::vector<bool> accessed_;
+    int cut_value_{0};
+    Migration last_migration_;
+    bool relabel_partitions_{true};
+
+    // Clique access graph decay. Each value remembers the epoch its weight
+    // and out edges were last halved to, and catches up when accessed.
+    int decay_half_life_{0};
+    int decay_min_weight_{1};
+    long long n_accesses_{0};
+    std::vector<int> decay_epoch_;
 };
 
 }
@@ -0,0 +1,80 @@
+#include "partition_set.h"
+
+namespace workload {
+
+PartitionSet::const_iterator::const_iterator(
+    const std::uint64_t* words, int word
+) : words_{words},
+    word_{word}
+{
+    skip_empty_words();
+}
+
+void PartitionSet::const_iterator::skip_empty_words() {
+    while (bits_ == 0 and word_ < N_WORDS) {
+        bits_ = words_[word_];
+        if (bits_ == 0) {
+            word_++;
+        }
+    }
+}
+
+int PartitionSet::const_iterator::operator*() const {
+    return word_ * 64 + __builtin_ctzll(bits_);
+}
+
+PartitionSet::const_iterator& PartitionSet::const_iterator::operator++() {
+    bits_ &= bits_ - 1;
+    if (bits_ == 0) {
+        word_++;
+        skip_empty_words();
+    }
+    return *this;
+}
+
+bool PartitionSet::const_iterator::operator==(const const_iterator& other) const {
+    return word_ == other.word_ and bits_ == other.bits_;
+}
+
+bool PartitionSet::const_iterator::operator!=(const const_iterator& other) const {
+    return not (*this == other);
+}
+
+void PartitionSet::insert(int partition) {
+    words_[partition / 64] |= std::uint64_t(1) << (partition % 64);
+}
+
+void PartitionSet::clear() {
+    words_.fill(0);
+}
+
+bool PartitionSet::contains(int partition) const {
+    return (words_[partition / 64] >> (partition % 64)) & 1;
+}
+
+bool PartitionSet::empty() const {
+    for (auto word : words_) {
+        if (word != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int PartitionSet::size() const {
+    auto size = 0;
+    for (auto word : words_) {
+        size += __builtin_popcountll(word);
+    }
+    return size;
+}
+
+PartitionSet::const_iterator PartitionSet::begin() const {
+    return const_iterator(words_.data(), 0);
+}
+
+PartitionSet::const_iterator PartitionSet::end() const {
+    return const_iterator(words_.data(), N_WORDS);
+}
+
+}
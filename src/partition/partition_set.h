@@ -0,0 +1,58 @@
+#ifndef MODEL_PARTITION_SET_H
+#define MODEL_PARTITION_SET_H
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+namespace workload {
+
+const int MAX_PARTITIONS = 256;
+
+// Fixed width bitset of partition ids, iterated in increasing order by
+// counting trailing zeros
+class PartitionSet {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        const_iterator(const std::uint64_t* words, int word);
+
+        int operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+
+    private:
+        void skip_empty_words();
+
+        const std::uint64_t* words_;
+        int word_;
+        std::uint64_t bits_{0};
+    };
+
+    PartitionSet() = default;
+
+    void insert(int partition);
+    void clear();
+    bool contains(int partition) const;
+    bool empty() const;
+    int size() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    static constexpr int N_WORDS = MAX_PARTITIONS / 64;
+
+    std::array<std::uint64_t, N_WORDS> words_{};
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include "partition_table.h"
+
+namespace workload {
+
+PartitionTable::PartitionTable(int n_dense_values)
+    : dense_(n_dense_values, NO_PARTITION)
+{}
+
+bool PartitionTable::is_dense(int value) const {
+    return value >= 0 and value < dense_.size();
+}
+
+void PartitionTable::set(int value, int partition) {
+    if (is_dense(value)) {
+        size_ += dense_[value] == NO_PARTITION;
+        dense_[value] = partition;
+    } else {
+        size_ += sparse_.find(value) == sparse_.end();
+        sparse_[value] = partition;
+    }
+}
+
+void PartitionTable::erase(int value) {
+    if (is_dense(value)) {
+        size_ -= dense_[value] != NO_PARTITION;
+        dense_[value] = NO_PARTITION;
+    } else {
+        size_ -= sparse_.erase(value);
+    }
+}
+
+bool PartitionTable::contains(int value) const {
+    return get(value) != -1;
+}
+
+int PartitionTable::get(int value) const {
+    if (is_dense(value)) {
+        auto partition = dense_[value];
+        return partition == NO_PARTITION ? -1 : partition;
+    }
+    auto it = sparse_.find(value);
+    return it == sparse_.end() ? -1 : it->second;
+}
+
+int PartitionTable::at(int value) const {
+    auto partition = get(value);
+    if (partition == -1) {
+        throw std::out_of_range("value " + std::to_string(value));
+    }
+    return partition;
+}
+
+std::size_t PartitionTable::size() const {
+    return size_;
+}
+
+int PartitionTable::n_dense_values() const {
+    return dense_.size();
+}
+
+std::unordered_map<int, int> PartitionTable::to_map() const {
+    auto map = std::unordered_map<int, int>();
+    for_each([&](int value, int partition) {
+        map.emplace(value, partition);
+    });
+    return map;
+}
+
+}
@@ -0,0 +1,55 @@
+#ifndef MODEL_PARTITION_TABLE_H
+#define MODEL_PARTITION_TABLE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace workload {
+
+// Partition of each value. Values below n_dense_values, the workload
+// variables, are looked up in a flat array; any other value falls back to
+// a hash map.
+class PartitionTable {
+public:
+    static constexpr std::uint16_t NO_PARTITION = UINT16_MAX;
+
+    PartitionTable() = default;
+    PartitionTable(int n_dense_values);
+
+    void set(int value, int partition);
+    void erase(int value);
+    bool contains(int value) const;
+    // -1 if the value has no partition
+    int get(int value) const;
+    int at(int value) const;
+    std::size_t size() const;
+    int n_dense_values() const;
+    std::unordered_map<int, int> to_map() const;
+
+    // Calls function(value, partition) for every value with a partition
+    template<typename Function>
+    void for_each(Function function) const {
+        for (auto value = 0; value < dense_.size(); value++) {
+            if (dense_[value] != NO_PARTITION) {
+                function(value, dense_[value]);
+            }
+        }
+        for (const auto& kv : sparse_) {
+            function(kv.first, kv.second);
+        }
+    }
+
+private:
+    bool is_dense(int value) const;
+
+    std::vector<std::uint16_t> dense_;
+    std::unordered_map<int, int> sparse_;
+    std::size_t size_{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "refennel_partitioner.h"
+
+namespace model {
+
+RefennelPartitioner::RefennelPartitioner(const FennelOptions& options)
+    : options_{options}
+{}
+
+// Vertex start in their installed partition: the last cut, relabeled, or
+// where the partition manager allocated the ones accessed since then
+void RefennelPartitioner::starting_assignment(
+    const workload::PartitionManager& partition_manager,
+    std::vector<int>& vertice_partition
+) const {
+    const auto& graph = partition_manager.access_graph();
+    for (const auto& kv : graph.vertex()) {
+        auto vertice = kv.first;
+        if (partition_manager.in_scheme(vertice)) {
+            vertice_partition[vertice] =
+                partition_manager.value_to_partition(vertice);
+        }
+    }
+}
+
+std::vector<workload::Partition> RefennelPartitioner::cut(
+    const workload::PartitionManager& partition_manager
+) {
+    const auto& graph = partition_manager.access_graph();
+    const auto n_partitions = partition_manager.n_partitions();
+
+    auto vertice_partition = std::vector<int>(graph.vertex_weights().size(), -1);
+    if (not first_repartition()) {
+        starting_assignment(partition_manager, vertice_partition);
+    }
+    partitions_weight_.assign(n_partitions, 0);
+    for (const auto& kv : graph.vertex()) {
+        if (vertice_partition[kv.first] != -1) {
+            partitions_weight_[vertice_partition[kv.first]] += kv.second;
+        }
+    }
+
+    pass_history_.push_back(restream_fennel(
+        graph,
+        vertex_order(
+            graph, options_.order, options_.seed, partition_manager.access_order()
+        ),
+        options_,
+        vertice_partition,
+        partitions_weight_
+    ));
+
+    std::vector<workload::Partition> partitions(n_partitions, workload::Partition());
+    for (const auto& kv : graph.vertex()) {
+        partitions[vertice_partition[kv.first]].insert(kv.first, kv.second);
+    }
+    return partitions;
+}
+
+void RefennelPartitioner::set_options(const FennelOptions& options) {
+    options_ = options;
+}
+
+bool RefennelPartitioner::first_repartition() const {
+    return pass_history_.empty();
+}
+
+const FennelOptions& RefennelPartitioner::options() const {
+    return options_;
+}
+
+const std::vector<int>& RefennelPartitioner::partitions_weight() const {
+    return partitions_weight_;
+}
+
+const std::vector<std::vector<int>>&
+RefennelPartitioner::pass_history() const {
+    return pass_history_;
+}
+
+}
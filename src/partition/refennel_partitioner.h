@@ -0,0 +1,47 @@
+#ifndef MODEL_REFENNEL_PARTITIONER_H
+#define MODEL_REFENNEL_PARTITIONER_H
+
+#include <vector>
+
+#include "graph/graph.h"
+#include "partition/min_cut.h"
+#include "partition/partition.h"
+#include "partition/partition_manager.h"
+
+namespace model {
+
+// REFENNEL state carried from one repartition to the next. The first cut
+// streams from scratch, later ones restream from the assignment installed
+// in the partition manager, so they follow its partition numbering.
+// Each instance is independent, but one instance must not cut from two
+// threads at once.
+class RefennelPartitioner {
+public:
+    RefennelPartitioner() = default;
+    RefennelPartitioner(const FennelOptions& options);
+
+    std::vector<workload::Partition> cut(
+        const workload::PartitionManager& partition_manager
+    );
+    void set_options(const FennelOptions& options);
+
+    bool first_repartition() const;
+    const FennelOptions& options() const;
+    const std::vector<int>& partitions_weight() const;
+    // Vertex placed or moved on each pass, one entry per cut
+    const std::vector<std::vector<int>>& pass_history() const;
+
+private:
+    void starting_assignment(
+        const workload::PartitionManager& partition_manager,
+        std::vector<int>& vertice_partition
+    ) const;
+
+    FennelOptions options_;
+    std::vector<int> partitions_weight_;
+    std::vector<std::vector<int>> pass_history_;
+};
+
+}
+
+#endif
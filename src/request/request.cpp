@@ -0,0 +1,133 @@
+#include "request.h"
+
+namespace workload {
+
+Request::Request(std::initializer_list<int> keys)
+    : Request(keys.begin(), keys.end())
+{}
+
+Request::Request(const Request& other) {
+    *this = other;
+}
+
+Request::Request(Request&& other) noexcept {
+    *this = std::move(other);
+}
+
+Request& Request::operator=(const Request& other) {
+    if (this != &other) {
+        size_ = 0;
+        reserve(other.size_);
+        std::copy(other.begin(), other.end(), keys());
+        size_ = other.size_;
+    }
+    return *this;
+}
+
+Request& Request::operator=(Request&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.heap_keys_ != nullptr) {
+        delete[] heap_keys_;
+        heap_keys_ = other.heap_keys_;
+        capacity_ = other.capacity_;
+        other.heap_keys_ = nullptr;
+        other.capacity_ = REQUEST_INLINE_KEYS;
+    } else {
+        std::copy(other.begin(), other.end(), keys());
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+}
+
+Request::~Request() {
+    delete[] heap_keys_;
+}
+
+int* Request::keys() {
+    return heap_keys_ != nullptr ? heap_keys_ : inline_keys_;
+}
+
+const int* Request::keys() const {
+    return heap_keys_ != nullptr ? heap_keys_ : inline_keys_;
+}
+
+void Request::reserve(std::size_t capacity) {
+    if (capacity <= capacity_) {
+        return;
+    }
+    auto* new_keys = new int[capacity];
+    std::copy(begin(), end(), new_keys);
+    delete[] heap_keys_;
+    heap_keys_ = new_keys;
+    capacity_ = capacity;
+}
+
+void Request::sort_keys() {
+    std::sort(keys(), keys() + size_);
+    size_ = std::unique(keys(), keys() + size_) - keys();
+}
+
+bool Request::insert(int key) {
+    auto* position = std::lower_bound(keys(), keys() + size_, key);
+    if (position != keys() + size_ and *position == key) {
+        return false;
+    }
+
+    auto index = position - keys();
+    if (size_ == capacity_) {
+        reserve(2 * capacity_);
+    }
+    std::copy_backward(keys() + index, keys() + size_, keys() + size_ + 1);
+    keys()[index] = key;
+    size_++;
+    return true;
+}
+
+void Request::clear() {
+    size_ = 0;
+}
+
+Request::const_iterator Request::begin() const {
+    return keys();
+}
+
+Request::const_iterator Request::end() const {
+    return keys() + size_;
+}
+
+std::size_t Request::size() const {
+    return size_;
+}
+
+bool Request::empty() const {
+    return size_ == 0;
+}
+
+Request::const_iterator Request::find(int key) const {
+    auto position = std::lower_bound(begin(), end(), key);
+    if (position != end() and *position == key) {
+        return position;
+    }
+    return end();
+}
+
+bool Request::contains(int key) const {
+    return find(key) != end();
+}
+
+std::size_t Request::count(int key) const {
+    return contains(key) ? 1 : 0;
+}
+
+bool Request::operator==(const Request& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
+
+bool Request::operator!=(const Request& other) const {
+    return not (*this == other);
+}
+
+}
@@ -0,0 +1,74 @@
+#ifndef WORKLOAD_REQUEST_H
+#define WORKLOAD_REQUEST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+namespace workload {
+
+// Keys of requests with more keys than this are kept in the heap
+const std::size_t REQUEST_INLINE_KEYS = 8;
+
+// Set of keys accessed by a request, kept sorted and without repetitions
+// in a small vector
+class Request {
+public:
+    typedef int value_type;
+    typedef const int* iterator;
+    typedef const int* const_iterator;
+
+    Request() = default;
+    Request(std::initializer_list<int> keys);
+    template <typename Iterator>
+    Request(Iterator first, Iterator last);
+    Request(const Request& other);
+    Request(Request&& other) noexcept;
+    Request& operator=(const Request& other);
+    Request& operator=(Request&& other) noexcept;
+    ~Request();
+
+    // Returns whether key was not in the request yet
+    bool insert(int key);
+    void clear();
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    std::size_t size() const;
+    bool empty() const;
+    const_iterator find(int key) const;
+    bool contains(int key) const;
+    std::size_t count(int key) const;
+
+    bool operator==(const Request& other) const;
+    bool operator!=(const Request& other) const;
+
+private:
+    int* keys();
+    const int* keys() const;
+    void reserve(std::size_t capacity);
+    void sort_keys();
+
+    std::uint32_t size_{0};
+    std::uint32_t capacity_{REQUEST_INLINE_KEYS};
+    int* heap_keys_{nullptr};
+    int inline_keys_[REQUEST_INLINE_KEYS];
+};
+
+template <typename Iterator>
+Request::Request(Iterator first, Iterator last) {
+    for (; first != last; first++) {
+        if (size_ == capacity_) {
+            reserve(2 * capacity_);
+        }
+        keys()[size_] = *first;
+        size_++;
+    }
+    sort_keys();
+}
+
+}
+
+#endif
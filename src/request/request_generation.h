@@ -10,11 +10,12 @@
 #include <vector>
 
 #include "random.h"
+#include "request.h"
+#include "trace_parser.h"
 
 namespace workload {
 
-typedef std::unordered_set<int> Request;
-
+void make_request(const TraceRecord& record, Request& request);
 std::vector<Request> import_requests(const std::string& input_path, int n_initial_keys);
 std::vector<Request> generate_single_data_requests(
     int n_requests,
@@ -0,0 +1,339 @@
+#include "request_source.h"
+
+namespace workload {
+
+VectorRequestSource::VectorRequestSource(std::vector<Request> requests)
+    : requests_{std::move(requests)}
+{}
+
+bool VectorRequestSource::next(Request& request) {
+    if (position_ == requests_.size()) {
+        return false;
+    }
+    request = std::move(requests_[position_]);
+    position_++;
+    return true;
+}
+
+SharedRequestSource::SharedRequestSource(
+    std::shared_ptr<const std::vector<Request>> requests
+) : requests_{std::move(requests)}
+{}
+
+bool SharedRequestSource::next(Request& request) {
+    if (position_ == requests_->size()) {
+        return false;
+    }
+    request = (*requests_)[position_];
+    position_++;
+    return true;
+}
+
+GeneratedRequestSource::GeneratedRequestSource(
+    int n_requests,
+    rfunc::RandFunction data_rand,
+    rfunc::RandFunction size_rand
+) : n_requests_{n_requests},
+    data_rand_{data_rand},
+    size_rand_{size_rand}
+{}
+
+bool GeneratedRequestSource::next(Request& request) {
+    if (generated_requests_ == n_requests_) {
+        return false;
+    }
+
+    request.clear();
+    auto request_size = size_rand_();
+    for (auto j = 0; j < request_size; j++) {
+        auto data = data_rand_();
+        while (request.find(data) != request.end()) {
+            data = data_rand_();
+        }
+        request.insert(data);
+    }
+
+    generated_requests_++;
+    return true;
+}
+
+FixedDataRequestSource::FixedDataRequestSource(
+    int n_variables, int requests_per_variable
+) {
+    variables_.reserve(n_variables * requests_per_variable);
+    for (auto i = 0; i < n_variables; i++) {
+        for (auto j = 0; j < requests_per_variable; j++) {
+            variables_.push_back(i);
+        }
+    }
+
+    // Same permutation shuffle_requests gives, as it only depends on size
+    auto rng = std::default_random_engine {};
+    std::shuffle(std::begin(variables_), std::end(variables_), rng);
+}
+
+bool FixedDataRequestSource::next(Request& request) {
+    if (position_ == variables_.size()) {
+        return false;
+    }
+    request.clear();
+    request.insert(variables_[position_]);
+    position_++;
+    return true;
+}
+
+FileRequestSource::FileRequestSource(
+    const std::string& file_path,
+    int n_initial_keys,
+    int n_threads /*= hardware_concurrency*/,
+    double* throughput /*= nullptr*/
+) : file_{file_path},
+    n_threads_{std::max(n_threads, 1)},
+    chunk_records_(n_threads_),
+    throughput_{throughput}
+{
+    for(auto i = 0; i < n_initial_keys; i++) {
+        inserted_keys_.insert(i);
+    }
+}
+
+bool FileRequestSource::next(Request& request) {
+    while (batch_position_ == batch_.size()) {
+        if (not parse_next_batch()) {
+            return false;
+        }
+    }
+    request = std::move(batch_[batch_position_]);
+    batch_position_++;
+    return true;
+}
+
+void FileRequestSource::parallel_for(
+    int n_tasks, const std::function<void(int)>& task
+) {
+    auto workers = std::vector<std::thread>();
+    for (auto i = 1; i < n_tasks; i++) {
+        workers.emplace_back(task, i);
+    }
+    task(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Records are found in parallel, but the inserted keys a range scan sees
+// depend on every record before it, so they are resolved in order before
+// the requests are built in parallel again
+bool FileRequestSource::parse_next_batch() {
+    if (position_ == file_.size()) {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    const auto* data = file_.data();
+    const auto* data_end = data + file_.size();
+    auto remaining_chunks = (file_.size() - position_ + TRACE_CHUNK_SIZE - 1)
+        / TRACE_CHUNK_SIZE;
+    auto n_chunks = (int) std::min<std::size_t>(n_threads_, remaining_chunks);
+    auto chunk_begin = [&](int chunk) {
+        return std::min(position_ + chunk * TRACE_CHUNK_SIZE, file_.size());
+    };
+
+    auto commas = std::vector<std::size_t>(n_chunks + 1, 0);
+    parallel_for(n_chunks, [&](int chunk) {
+        commas[chunk + 1] = count_commas(
+            data + chunk_begin(chunk), data + chunk_begin(chunk + 1)
+        );
+    });
+    commas[0] = commas_before_;
+    for (auto chunk = 0; chunk < n_chunks; chunk++) {
+        commas[chunk + 1] += commas[chunk];
+    }
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    parallel_for(n_chunks, [&](int chunk) {
+        chunk_records_[chunk].clear();
+        try {
+            parse_trace_records(
+                data,
+                data_end,
+                data + chunk_begin(chunk),
+                data + chunk_begin(chunk + 1),
+                commas[chunk],
+                chunk_records_[chunk]
+            );
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            error = std::current_exception();
+        }
+    });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    auto offsets = std::vector<std::size_t>(n_chunks + 1, 0);
+    for (auto chunk = 0; chunk < n_chunks; chunk++) {
+        for (auto& record : chunk_records_[chunk]) {
+            record.n_keys = inserted_keys_.size();
+            if (record.type == 1) {
+                inserted_keys_.insert(record.key);
+            }
+        }
+        offsets[chunk + 1] = offsets[chunk] + chunk_records_[chunk].size();
+    }
+
+    batch_.resize(offsets[n_chunks]);
+    batch_position_ = 0;
+    parallel_for(n_chunks, [&](int chunk) {
+        auto request_index = offsets[chunk];
+        for (const auto& record : chunk_records_[chunk]) {
+            make_request(record, batch_[request_index]);
+            request_index++;
+        }
+    });
+
+    parsed_bytes_ += chunk_begin(n_chunks) - position_;
+    position_ = chunk_begin(n_chunks);
+    commas_before_ = commas[n_chunks];
+    parse_time_ += std::chrono::steady_clock::now() - start;
+    if (throughput_ != nullptr and parse_time_.count() != 0) {
+        *throughput_ = parsed_bytes_ / (1024.0 * 1024.0) / parse_time_.count();
+    }
+    return true;
+}
+
+ConcatenatedRequestSource::ConcatenatedRequestSource(
+    std::vector<std::unique_ptr<RequestSource>> sources
+) : sources_{std::move(sources)}
+{}
+
+bool ConcatenatedRequestSource::next(Request& request) {
+    while (current_source_ < sources_.size()) {
+        if (sources_[current_source_]->next(request)) {
+            return true;
+        }
+        current_source_++;
+    }
+    return false;
+}
+
+MergedRequestSource::MergedRequestSource(
+    std::unique_ptr<RequestSource> single_data,
+    std::unique_ptr<RequestSource> multi_data,
+    int single_data_pick_probability
+) : single_data_{std::move(single_data)},
+    multi_data_{std::move(multi_data)},
+    single_data_pick_probability_{single_data_pick_probability},
+    rand_{rfunc::uniform_distribution_rand(1, 100)}
+{}
+
+void MergedRequestSource::take(
+    RequestSource& source, Request& head, bool& has_head, Request& request
+) {
+    request = std::move(head);
+    has_head = source.next(head);
+}
+
+bool MergedRequestSource::next(Request& request) {
+    if (not started_) {
+        has_single_data_head_ = single_data_->next(single_data_head_);
+        has_multi_data_head_ = multi_data_->next(multi_data_head_);
+        started_ = true;
+    }
+
+    auto pick_single_data = has_single_data_head_;
+    if (has_single_data_head_ and has_multi_data_head_) {
+        pick_single_data = single_data_pick_probability_ > rand_();
+    }
+
+    if (pick_single_data) {
+        take(*single_data_, single_data_head_, has_single_data_head_, request);
+    } else if (has_multi_data_head_) {
+        take(*multi_data_, multi_data_head_, has_multi_data_head_, request);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+BufferedRequestSource::BufferedRequestSource(
+    std::unique_ptr<RequestSource> source, std::size_t capacity
+) : source_{std::move(source)},
+    buffer_(std::max<std::size_t>(capacity, 1))
+{
+    producer_ = std::thread(&BufferedRequestSource::produce, this);
+}
+
+BufferedRequestSource::~BufferedRequestSource() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    not_full_.notify_one();
+    producer_.join();
+}
+
+void BufferedRequestSource::produce() {
+    auto request = Request();
+    while (true) {
+        auto has_request = false;
+        auto error = std::exception_ptr();
+        try {
+            has_request = source_->next(request);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() {
+            return stopped_ or size_ != buffer_.size();
+        });
+        if (stopped_) {
+            return;
+        }
+        if (not has_request) {
+            exhausted_ = true;
+            error_ = error;
+            lock.unlock();
+            not_empty_.notify_one();
+            return;
+        }
+
+        std::swap(buffer_[(head_ + size_) % buffer_.size()], request);
+        size_++;
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+}
+
+bool BufferedRequestSource::next(Request& request) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() {
+        return exhausted_ or size_ != 0;
+    });
+    if (size_ == 0) {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return false;
+    }
+
+    std::swap(request, buffer_[head_]);
+    head_ = (head_ + 1) % buffer_.size();
+    size_--;
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+}
+
+std::vector<Request> collect_requests(RequestSource& source) {
+    auto requests = std::vector<Request>();
+    auto request = Request();
+    while (source.next(request)) {
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+}
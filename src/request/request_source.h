@@ -0,0 +1,194 @@
+#ifndef WORKLOAD_REQUEST_SOURCE_H
+#define WORKLOAD_REQUEST_SOURCE_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "random.h"
+#include "request_generation.h"
+#include "trace_parser.h"
+
+namespace workload {
+
+// Pull based stream of requests, so a workload never has to be held in
+// memory as a whole
+class RequestSource {
+public:
+    virtual ~RequestSource() = default;
+
+    // Writes the next request, returns false (and keeps doing so) once
+    // the stream is exhausted
+    virtual bool next(Request& request) = 0;
+};
+
+class VectorRequestSource : public RequestSource {
+public:
+    VectorRequestSource() = default;
+    VectorRequestSource(std::vector<Request> requests);
+
+    bool next(Request& request);
+
+private:
+    std::vector<Request> requests_;
+    std::size_t position_{0};
+};
+
+// Reads, without copying it, a workload several sources share read only
+class SharedRequestSource : public RequestSource {
+public:
+    SharedRequestSource(std::shared_ptr<const std::vector<Request>> requests);
+
+    bool next(Request& request);
+
+private:
+    std::shared_ptr<const std::vector<Request>> requests_;
+    std::size_t position_{0};
+};
+
+// Requests of size_rand() distinct values picked by data_rand
+class GeneratedRequestSource : public RequestSource {
+public:
+    GeneratedRequestSource(
+        int n_requests,
+        rfunc::RandFunction data_rand,
+        rfunc::RandFunction size_rand
+    );
+
+    bool next(Request& request);
+
+private:
+    int n_requests_;
+    int generated_requests_{0};
+    rfunc::RandFunction data_rand_;
+    rfunc::RandFunction size_rand_;
+};
+
+// requests_per_variable single data requests on every variable, shuffled.
+// Only the shuffled variable order is kept in memory.
+class FixedDataRequestSource : public RequestSource {
+public:
+    FixedDataRequestSource(int n_variables, int requests_per_variable);
+
+    bool next(Request& request);
+
+private:
+    std::vector<int> variables_;
+    std::size_t position_{0};
+};
+
+// Reads the type,key,arg, records of a memory mapped trace file as they
+// are needed, n_threads chunks of TRACE_CHUNK_SIZE bytes at a time parsed
+// in parallel. If given, throughput is kept updated with the MB parsed per
+// second spent parsing.
+class FileRequestSource : public RequestSource {
+public:
+    FileRequestSource(
+        const std::string& file_path,
+        int n_initial_keys,
+        int n_threads = std::thread::hardware_concurrency(),
+        double* throughput = nullptr
+    );
+
+    bool next(Request& request);
+
+private:
+    bool parse_next_batch();
+    void parallel_for(int n_tasks, const std::function<void(int)>& task);
+
+    MappedFile file_;
+    int n_threads_;
+    std::size_t position_{0};
+    std::size_t commas_before_{0};
+    std::unordered_set<int> inserted_keys_;
+
+    std::vector<std::vector<TraceRecord>> chunk_records_;
+    std::vector<Request> batch_;
+    std::size_t batch_position_{0};
+
+    std::size_t parsed_bytes_{0};
+    std::chrono::duration<double> parse_time_{0};
+    double* throughput_;
+};
+
+class ConcatenatedRequestSource : public RequestSource {
+public:
+    ConcatenatedRequestSource(std::vector<std::unique_ptr<RequestSource>> sources);
+
+    bool next(Request& request);
+
+private:
+    std::vector<std::unique_ptr<RequestSource>> sources_;
+    std::size_t current_source_{0};
+};
+
+// Picks from single_data with single_data_pick_probability% chance while
+// both streams have requests, then drains the remaining one
+class MergedRequestSource : public RequestSource {
+public:
+    MergedRequestSource(
+        std::unique_ptr<RequestSource> single_data,
+        std::unique_ptr<RequestSource> multi_data,
+        int single_data_pick_probability
+    );
+
+    bool next(Request& request);
+
+private:
+    void take(
+        RequestSource& source, Request& head, bool& has_head, Request& request
+    );
+
+    std::unique_ptr<RequestSource> single_data_;
+    std::unique_ptr<RequestSource> multi_data_;
+    int single_data_pick_probability_;
+    rfunc::RandFunction rand_;
+
+    bool started_{false};
+    Request single_data_head_, multi_data_head_;
+    bool has_single_data_head_{false}, has_multi_data_head_{false};
+};
+
+// A producer thread pulls from source ahead of the consumer into a ring
+// buffer of capacity requests. Errors raised while producing are rethrown
+// by next.
+class BufferedRequestSource : public RequestSource {
+public:
+    BufferedRequestSource(
+        std::unique_ptr<RequestSource> source, std::size_t capacity
+    );
+    ~BufferedRequestSource();
+
+    bool next(Request& request);
+
+private:
+    void produce();
+
+    std::unique_ptr<RequestSource> source_;
+    std::vector<Request> buffer_;
+    std::size_t head_{0};
+    std::size_t size_{0};
+    bool exhausted_{false};
+    bool stopped_{false};
+    std::exception_ptr error_;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::thread producer_;
+};
+
+std::vector<Request> collect_requests(RequestSource& source);
+
+}
+
+#endif
@@ -0,0 +1,222 @@
+#include "trace_format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <toml11/toml.hpp>
+
+namespace workload {
+
+BinaryTraceWriter::BinaryTraceWriter(
+    std::ostream& output_stream, int n_variables
+) : output_stream_(output_stream),
+    position_{sizeof(BinaryTraceHeader)}
+{
+    std::memcpy(header_.magic, BINARY_TRACE_MAGIC, sizeof(header_.magic));
+    header_.version = BINARY_TRACE_VERSION;
+    header_.n_variables = n_variables;
+    header_.n_requests = 0;
+    header_.n_keys = 0;
+    header_.offsets_position = 0;
+
+    // Written for real by close
+    output_stream_.write(
+        reinterpret_cast<const char*>(&header_), sizeof(header_)
+    );
+    offsets_.push_back(position_);
+}
+
+void BinaryTraceWriter::write_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+        encoding_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    encoding_.push_back(static_cast<char>(value));
+}
+
+void BinaryTraceWriter::write(const Request& request) {
+    encoding_.clear();
+    auto previous = 0ll;
+    for (auto it = request.begin(); it != request.end(); it++) {
+        auto key = (long long) *it;
+        if (it == request.begin()) {
+            write_varint(((std::uint64_t) key << 1) ^ (std::uint64_t) (key >> 63));
+        } else {
+            write_varint(key - previous);
+        }
+        previous = key;
+    }
+
+    output_stream_.write(encoding_.data(), encoding_.size());
+    position_ += encoding_.size();
+    offsets_.push_back(position_);
+    header_.n_requests++;
+    header_.n_keys += request.size();
+}
+
+void BinaryTraceWriter::close() {
+    // Aligns the offsets column so it can be read in place
+    auto padding = (8 - position_ % 8) % 8;
+    output_stream_.write("\0\0\0\0\0\0\0", padding);
+    header_.offsets_position = position_ + padding;
+    output_stream_.write(
+        reinterpret_cast<const char*>(offsets_.data()),
+        offsets_.size() * sizeof(std::uint64_t)
+    );
+
+    output_stream_.seekp(0);
+    output_stream_.write(
+        reinterpret_cast<const char*>(&header_), sizeof(header_)
+    );
+    output_stream_.seekp(0, std::ios_base::end);
+    output_stream_.flush();
+    if (not output_stream_) {
+        throw std::runtime_error("Could not write binary trace");
+    }
+}
+
+BinaryTraceRequestSource::BinaryTraceRequestSource(const std::string& file_path)
+    : file_{file_path}
+{
+    if (file_.size() < sizeof(header_)) {
+        throw std::runtime_error(file_path + " is not a binary trace");
+    }
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, BINARY_TRACE_MAGIC, sizeof(header_.magic)) != 0) {
+        throw std::runtime_error(file_path + " is not a binary trace");
+    }
+    if (header_.version != BINARY_TRACE_VERSION) {
+        throw std::runtime_error(
+            file_path + " has unsupported binary trace version " +
+            std::to_string(header_.version)
+        );
+    }
+    if (header_.offsets_position > file_.size()) {
+        throw std::runtime_error(file_path + " is truncated");
+    }
+    // Compared this way so a corrupted n_requests can't overflow
+    auto n_offsets =
+        (file_.size() - header_.offsets_position) / sizeof(std::uint64_t);
+    if (n_offsets == 0 or header_.n_requests > n_offsets - 1) {
+        throw std::runtime_error(file_path + " is truncated");
+    }
+}
+
+std::uint64_t BinaryTraceRequestSource::offset(std::uint64_t request) const {
+    auto value = std::uint64_t(0);
+    std::memcpy(
+        &value,
+        file_.data() + header_.offsets_position + request * sizeof(value),
+        sizeof(value)
+    );
+    return value;
+}
+
+bool BinaryTraceRequestSource::next(Request& request) {
+    if (next_request_ == header_.n_requests) {
+        return false;
+    }
+
+    auto begin_offset = offset(next_request_);
+    auto end_offset = offset(next_request_ + 1);
+    if (begin_offset < sizeof(header_) or begin_offset > end_offset or
+        end_offset > header_.offsets_position)
+    {
+        throw std::runtime_error("Corrupted binary trace");
+    }
+    const auto* position = reinterpret_cast<const unsigned char*>(
+        file_.data() + begin_offset
+    );
+    const auto* end = reinterpret_cast<const unsigned char*>(
+        file_.data() + end_offset
+    );
+    next_request_++;
+
+    request.clear();
+    auto key = 0ll;
+    auto first = true;
+    while (position != end) {
+        auto value = std::uint64_t(0);
+        auto shift = 0;
+        while (true) {
+            if (position == end or shift > 63) {
+                throw std::runtime_error("Corrupted binary trace");
+            }
+            auto byte = *position;
+            position++;
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            shift += 7;
+            if (not (byte & 0x80)) {
+                break;
+            }
+        }
+
+        if (first) {
+            key = (long long) (value >> 1) ^ -(long long) (value & 1);
+            first = false;
+        } else if (value <= std::numeric_limits<std::uint32_t>::max()) {
+            key += value;
+        } else {
+            throw std::runtime_error("Corrupted binary trace");
+        }
+        if (key < std::numeric_limits<int>::min() or
+            key > std::numeric_limits<int>::max())
+        {
+            throw std::runtime_error("Corrupted binary trace");
+        }
+        request.insert(key);
+    }
+    return true;
+}
+
+const BinaryTraceHeader& BinaryTraceRequestSource::header() const {
+    return header_;
+}
+
+bool is_binary_trace(const std::string& file_path) {
+    std::ifstream input_stream(file_path, std::ifstream::binary);
+    char magic[sizeof(BINARY_TRACE_MAGIC)];
+    input_stream.read(magic, sizeof(magic));
+    return input_stream and
+        std::memcmp(magic, BINARY_TRACE_MAGIC, sizeof(magic)) == 0;
+}
+
+void write_binary_trace(
+    std::ostream& output_stream, RequestSource& source, int n_variables
+) {
+    auto writer = BinaryTraceWriter(output_stream, n_variables);
+    auto request = Request();
+    while (source.next(request)) {
+        writer.write(request);
+    }
+    writer.close();
+}
+
+void write_toml_trace(
+    std::ostream& output_stream, const std::vector<Request>& requests
+) {
+    toml::array toml_array;
+    for (const auto& request : requests) {
+        toml_array.push_back(std::vector<int>(request.begin(), request.end()));
+    }
+    const toml::value data(toml_array);
+    output_stream << "requests = ";
+    output_stream << std::setw(80) << data << std::endl;
+}
+
+std::vector<Request> read_toml_trace(const std::string& file_path) {
+    const auto requests_file = toml::parse(file_path);
+    const auto requests_vector = toml::find<std::vector<std::vector<int>>>(
+        requests_file, "requests"
+    );
+    auto requests = std::vector<Request>();
+    for (const auto& request_vector : requests_vector) {
+        requests.emplace_back(request_vector.begin(), request_vector.end());
+    }
+    return requests;
+}
+
+}
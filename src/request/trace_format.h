@@ -0,0 +1,91 @@
+#ifndef WORKLOAD_TRACE_FORMAT_H
+#define WORKLOAD_TRACE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "request_generation.h"
+#include "request_source.h"
+#include "trace_parser.h"
+
+namespace workload {
+
+enum TraceFormat {BINARY, TOML};
+const std::unordered_map<std::string, TraceFormat> string_to_trace_format({
+    {"BINARY", TraceFormat::BINARY},
+    {"TOML", TraceFormat::TOML}
+});
+
+const char BINARY_TRACE_MAGIC[8] = {'P', 'S', 'M', 'R', 'T', 'R', 'C', '\0'};
+const std::uint32_t BINARY_TRACE_VERSION = 1;
+
+// A binary trace is this header, the keys column and the offsets column.
+// The header and offsets are in the byte order of the host that wrote the
+// trace, so they can be read in place, and traces aren't portable across
+// hosts of different endianness. Each request is stored in the keys
+// column as its sorted keys, the first one zigzag varint encoded and the
+// others as varint deltas to the previous one. The offsets column holds
+// n_requests + 1 byte positions of the requests encodings, so request i
+// spans [offsets[i], offsets[i + 1]).
+struct BinaryTraceHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t n_variables;
+    std::uint64_t n_requests;
+    std::uint64_t n_keys;
+    std::uint64_t offsets_position;
+};
+
+// Writes requests as they come, the header and offsets are written by
+// close, so output_stream must be seekable
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter(std::ostream& output_stream, int n_variables);
+
+    void write(const Request& request);
+    void close();
+
+private:
+    void write_varint(std::uint64_t value);
+
+    std::ostream& output_stream_;
+    BinaryTraceHeader header_;
+    std::uint64_t position_;
+    std::vector<std::uint64_t> offsets_;
+    std::vector<char> encoding_;
+};
+
+// Decodes a memory mapped binary trace
+class BinaryTraceRequestSource : public RequestSource {
+public:
+    BinaryTraceRequestSource(const std::string& file_path);
+
+    bool next(Request& request);
+    const BinaryTraceHeader& header() const;
+
+private:
+    std::uint64_t offset(std::uint64_t request) const;
+
+    MappedFile file_;
+    BinaryTraceHeader header_;
+    std::uint64_t next_request_{0};
+};
+
+bool is_binary_trace(const std::string& file_path);
+
+void write_binary_trace(
+    std::ostream& output_stream, RequestSource& source, int n_variables
+);
+// The requests = [[...], ...] form traces were first exported in
+void write_toml_trace(
+    std::ostream& output_stream, const std::vector<Request>& requests
+);
+std::vector<Request> read_toml_trace(const std::string& file_path);
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "trace_parser.h"
+
+#include <algorithm>
+#include <climits>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace workload {
+
+MappedFile::MappedFile(const std::string& file_path) {
+    auto descriptor = open(file_path.c_str(), O_RDONLY);
+    if (descriptor == -1) {
+        throw std::runtime_error("Could not open " + file_path);
+    }
+
+    struct stat file_status;
+    if (fstat(descriptor, &file_status) == -1) {
+        close(descriptor);
+        throw std::runtime_error("Could not stat " + file_path);
+    }
+
+    size_ = file_status.st_size;
+    if (size_ != 0) {
+        auto* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            throw std::runtime_error("Could not map " + file_path);
+        }
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapping);
+    }
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+const char* MappedFile::data() const {
+    return data_;
+}
+
+std::size_t MappedFile::size() const {
+    return size_;
+}
+
+std::size_t count_commas(const char* begin, const char* end) {
+    return std::count(begin, end, ',');
+}
+
+// Reads a field up to its comma, leaving position past it. Like std::stoi,
+// leading blanks are skipped and anything after the digits is ignored.
+// Returns false if data_end comes before the comma.
+bool scan_field(
+    const char*& position, const char* data_end, int& value, bool parse
+) {
+    auto number = 0ll;
+    auto sign = 1;
+    auto digits = 0;
+    auto in_number = parse;
+    auto started = false;
+
+    for (; position != data_end; position++) {
+        auto character = *position;
+        if (character == ',') {
+            break;
+        }
+        if (character == '\n' or not in_number) {
+            continue;
+        }
+
+        if (character >= '0' and character <= '9') {
+            started = true;
+            digits++;
+            number = number * 10 + (character - '0');
+            if (number > (long long) INT_MAX + 1) {
+                throw std::out_of_range("Trace field out of int range");
+            }
+        } else if (not started and (character == ' ' or character == '\t' or
+                                    character == '\r'))
+        {
+            continue;
+        } else if (not started and (character == '-' or character == '+')) {
+            started = true;
+            sign = character == '-' ? -1 : 1;
+        } else {
+            in_number = false;
+        }
+    }
+
+    if (position == data_end) {
+        return false;
+    }
+    position++;
+
+    if (parse) {
+        number *= sign;
+        if (digits == 0) {
+            throw std::invalid_argument("Trace field is not a number");
+        }
+        if (number > INT_MAX or number < INT_MIN) {
+            throw std::out_of_range("Trace field out of int range");
+        }
+        value = number;
+    }
+    return true;
+}
+
+void parse_trace_records(
+    const char* data,
+    const char* data_end,
+    const char* begin,
+    const char* end,
+    std::size_t commas_before,
+    std::vector<TraceRecord>& records
+) {
+    // Skip the tail of a record that started before begin
+    auto position = begin;
+    auto fields_read = commas_before % 3;
+    auto at_record_start = fields_read == 0 and
+        (begin == data or *(begin - 1) == ',');
+    if (not at_record_start) {
+        auto remaining_commas = 3 - fields_read;
+        while (remaining_commas != 0 and position != data_end) {
+            if (*position == ',') {
+                remaining_commas--;
+            }
+            position++;
+        }
+    }
+
+    while (position < end) {
+        auto record = TraceRecord{0, 0, 0, 0};
+        auto complete = scan_field(position, data_end, record.type, true) and
+            scan_field(position, data_end, record.key, true) and
+            scan_field(position, data_end, record.arg, record.type == 2);
+        if (not complete) {
+            return;
+        }
+        records.push_back(record);
+    }
+}
+
+}
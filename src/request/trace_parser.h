@@ -0,0 +1,56 @@
+#ifndef WORKLOAD_TRACE_PARSER_H
+#define WORKLOAD_TRACE_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace workload {
+
+// Bytes of trace each thread parses at a time
+const std::size_t TRACE_CHUNK_SIZE = 1 << 20;
+
+// One type,key,arg, record of a trace. arg is only read for range scans
+// (type 2), n_keys is the number of inserted keys when the record is
+// reached and is filled in afterwards.
+struct TraceRecord {
+    int type;
+    int key;
+    int arg;
+    int n_keys;
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile(const std::string& file_path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const;
+    std::size_t size() const;
+
+private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+std::size_t count_commas(const char* begin, const char* end);
+
+// Appends the records of data starting inside [begin, end). Records start
+// at data and after every third comma, commas_before being the number of
+// commas in [data, begin). The last record may end past end, an incomplete
+// record at data_end is dropped. Line breaks are ignored anywhere.
+void parse_trace_records(
+    const char* data,
+    const char* data_end,
+    const char* begin,
+    const char* end,
+    std::size_t commas_before,
+    std::vector<TraceRecord>& records
+);
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#include "concurrent_ready_queue.h"
+
+namespace simulation {
+
+ConcurrentReadyQueue::ConcurrentReadyQueue(std::size_t capacity) {
+    auto size = std::size_t(2);
+    while (size < capacity) {
+        size *= 2;
+    }
+    cells_ = std::vector<Cell>(size);
+    mask_ = size - 1;
+    for (auto i = 0; i < size; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ConcurrentReadyQueue::push(int request, long long& retries) {
+    auto position = push_position_.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = cells_[position & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = (long long) sequence - (long long) position;
+        if (difference == 0) {
+            if (push_position_.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+            {
+                cell.request = request;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+            retries++;
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = push_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ConcurrentReadyQueue::pop(int& request, long long& retries) {
+    auto position = pop_position_.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = cells_[position & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference = (long long) sequence - (long long) (position + 1);
+        if (difference == 0) {
+            if (pop_position_.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+            {
+                request = cell.request;
+                cell.sequence.store(
+                    position + mask_ + 1, std::memory_order_release
+                );
+                return true;
+            }
+            retries++;
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = pop_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}
@@ -0,0 +1,36 @@
+#ifndef SIMULATION_CONCURRENT_READY_QUEUE_H
+#define SIMULATION_CONCURRENT_READY_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace simulation {
+
+// Bounded lock-free multi-producer multi-consumer FIFO of request ids
+// (Vyukov's ring of sequenced cells). The capacity is rounded up to a power
+// of two. Retries count the compare-and-swaps lost to other threads.
+class ConcurrentReadyQueue {
+public:
+    ConcurrentReadyQueue(std::size_t capacity);
+
+    // false if the queue is full
+    bool push(int request, long long& retries);
+    // false if the queue is empty
+    bool pop(int& request, long long& retries);
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        int request;
+    };
+
+    std::vector<Cell> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> push_position_{0};
+    alignas(64) std::atomic<std::size_t> pop_position_{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "dependency_window.h"
+
+namespace simulation {
+
+DependencyWindow::DependencyWindow(int n_keys /*= 0*/):
+    dense_last_access_(std::max(n_keys, 0))
+{}
+
+DependencyWindow::LastAccess& DependencyWindow::last_access(int key) {
+    if (key >= 0 and key < dense_last_access_.size()) {
+        return dense_last_access_[key];
+    }
+    return sparse_last_access_[key];
+}
+
+void DependencyWindow::add_successor(int slot, int successor) {
+    auto edge = free_edges_;
+    if (edge == NO_EDGE) {
+        edge = edges_.size();
+        edges_.emplace_back();
+    } else {
+        free_edges_ = edges_[edge].next;
+    }
+    edges_[edge] = Edge{successor, vertex_[slot].first_successor};
+    vertex_[slot].first_successor = edge;
+}
+
+void DependencyWindow::admit(
+    const workload::Request& request, int not_before, EventQueue& ready
+) {
+    auto slot = 0;
+    if (free_slots_.empty()) {
+        slot = vertex_.size();
+        vertex_.emplace_back();
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+
+    auto& vertex = vertex_[slot];
+    vertex.id = admitted_requests_++;
+    vertex.ready_moment = not_before;
+    vertex.first_successor = NO_EDGE;
+    vertex.request = request;
+
+    dependencies_.clear();
+    for (auto key : request) {
+        auto& key_access = last_access(key);
+        if (key_access.slot != -1) {
+            dependencies_.push_back(key_access.slot);
+        } else {
+            vertex.ready_moment = std::max(
+                vertex.ready_moment, key_access.release_moment
+            );
+        }
+        key_access = LastAccess{slot, 0};
+    }
+    std::sort(dependencies_.begin(), dependencies_.end());
+    dependencies_.erase(
+        std::unique(dependencies_.begin(), dependencies_.end()),
+        dependencies_.end()
+    );
+    for (auto dependency : dependencies_) {
+        add_successor(dependency, slot);
+    }
+
+    vertex.in_degree = dependencies_.size();
+    if (vertex.in_degree == 0) {
+        ready.push(Event{vertex.ready_moment, vertex.id, slot, 0});
+    }
+    size_++;
+}
+
+void DependencyWindow::retire(int slot, EventQueue& ready) {
+    auto& vertex = vertex_[slot];
+    auto release_moment = vertex.ready_moment + 1;
+    auto edge = vertex.first_successor;
+    while (edge != NO_EDGE) {
+        auto successor_slot = edges_[edge].successor;
+        auto& successor = vertex_[successor_slot];
+        successor.ready_moment = std::max(successor.ready_moment, release_moment);
+        successor.in_degree--;
+        if (successor.in_degree == 0) {
+            ready.push(
+                Event{successor.ready_moment, successor.id, successor_slot, 0}
+            );
+        }
+
+        auto next = edges_[edge].next;
+        edges_[edge].next = free_edges_;
+        free_edges_ = edge;
+        edge = next;
+    }
+    vertex.first_successor = NO_EDGE;
+
+    for (auto key : vertex.request) {
+        auto& key_access = last_access(key);
+        if (key_access.slot == slot) {
+            key_access = LastAccess{-1, release_moment};
+        }
+    }
+    free_slots_.push_back(slot);
+    size_--;
+}
+
+std::size_t DependencyWindow::size() const {
+    return size_;
+}
+
+}
@@ -0,0 +1,79 @@
+#ifndef SIMULATION_DEPENDENCY_WINDOW_H
+#define SIMULATION_DEPENDENCY_WINDOW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "event_queue.h"
+#include "request/request.h"
+
+namespace simulation {
+
+// In-flight part of the CBase dependency DAG: the requests admitted and not
+// executed yet, each depending on the last admitted request that accessed
+// any of its keys. Only the last writer of every key is remembered, and
+// request slots are recycled, so memory follows the number of requests in
+// flight and of keys instead of the trace length.
+//
+// A request becomes ready one time unit after the ready moment of its
+// latest dependency. Ready requests are pushed to the given queue as
+// Event{ready moment, request id, slot}.
+//
+// Successor lists are linked through a single edge pool whose entries are
+// recycled on retirement, and keys below n_keys are looked up in a flat
+// table, so neither admitting nor retiring allocates once the window is
+// warm.
+class DependencyWindow {
+public:
+    explicit DependencyWindow(int n_keys = 0);
+
+    // The request isn't ready before not_before
+    void admit(const workload::Request& request, int not_before, EventQueue& ready);
+    // Removes an executed request, pushing the ones it was the last
+    // dependency of
+    void retire(int slot, EventQueue& ready);
+
+    std::size_t size() const;
+
+private:
+    static constexpr int NO_EDGE = -1;
+
+    struct Vertex {
+        long long id;
+        int ready_moment;
+        int in_degree;
+        int first_successor;
+        workload::Request request;
+    };
+
+    struct Edge {
+        int successor;
+        int next;
+    };
+
+    // Slot of the last request that accessed a key, -1 once it executed
+    // and, from then on, the moment requests depending on it can start
+    struct LastAccess {
+        int slot{-1};
+        int release_moment{0};
+    };
+
+    LastAccess& last_access(int key);
+    void add_successor(int slot, int successor);
+
+    std::vector<Vertex> vertex_;
+    std::vector<int> free_slots_;
+    std::vector<Edge> edges_;
+    int free_edges_{NO_EDGE};
+    std::vector<LastAccess> dense_last_access_;
+    std::unordered_map<int, LastAccess> sparse_last_access_;
+    std::vector<int> dependencies_;
+    long long admitted_requests_{0};
+    std::size_t size_{0};
+};
+
+}
+
+#endif
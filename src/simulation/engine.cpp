@@ -0,0 +1,116 @@
+#include "engine.h"
+
+namespace simulation {
+
+Engine::Engine(
+    workload::ExecutionLog& log,
+    ExecutionPolicy policy,
+    int execution_time /*= 1*/
+) : log_{log},
+    policy_{policy},
+    execution_time_{execution_time},
+    ready_queues_(log.n_threads())
+{
+    if (log.n_threads() > workload::MAX_PARTITIONS) {
+        throw std::invalid_argument(
+            "at most " + std::to_string(workload::MAX_PARTITIONS) + " partitions"
+        );
+    }
+}
+
+void Engine::submit(const workload::PartitionSet& partitions) {
+    if (partitions.empty()) {
+        return;
+    }
+
+    auto request = pool_.acquire();
+    auto& pooled_request = pool_.at(request);
+    pooled_request.kind = EXECUTE;
+    pooled_request.partitions = partitions;
+    submitted_requests_++;
+    enqueue(request);
+}
+
+void Engine::barrier() {
+    auto request = pool_.acquire();
+    auto& pooled_request = pool_.at(request);
+    pooled_request.kind = BARRIER;
+    for (auto partition = 0; partition < ready_queues_.size(); partition++) {
+        pooled_request.partitions.insert(partition);
+    }
+    enqueue(request);
+}
+
+void Engine::enqueue(int request) {
+    auto& pooled_request = pool_.at(request);
+    pooled_request.pending = pooled_request.partitions.size();
+    for (auto partition : pooled_request.partitions) {
+        auto& ready_queue = ready_queues_[partition];
+        ready_queue.push(request);
+        if (ready_queue.size() == 1) {
+            schedule_head(partition);
+        }
+    }
+}
+
+void Engine::schedule_head(int partition) {
+    auto event = Event();
+    event.time = log_.elapsed_time(partition);
+    event.key = event_counter_++;
+    event.target = partition;
+    event.request = ready_queues_[partition].front();
+    events_.push(event);
+}
+
+void Engine::run() {
+    while (not events_.empty()) {
+        auto event = events_.pop();
+        auto& pooled_request = pool_.at(event.request);
+        pooled_request.pending--;
+        if (pooled_request.pending == 0) {
+            start(event.request);
+        }
+    }
+}
+
+void Engine::start(int request) {
+    const auto& partitions = pool_.at(request).partitions;
+
+    if (pool_.at(request).kind == BARRIER) {
+        log_.sync_all_partitions();
+    } else if (policy_ == EXECUTE_ON_LONGEST) {
+        auto executing_partition =
+            log_.partition_with_longest_execution(partitions);
+        log_.execute_request(executing_partition, execution_time_);
+        if (partitions.size() > 1) {
+            log_.sync_partitions(partitions);
+        }
+        for (auto partition : partitions) {
+            if (partition != executing_partition) {
+                log_.increase_elapsed_time(partition, execution_time_);
+            }
+        }
+    } else {
+        if (partitions.size() > 1) {
+            log_.sync_partitions(partitions);
+        }
+        for (auto partition : partitions) {
+            log_.increase_elapsed_time(partition, execution_time_);
+        }
+    }
+
+    for (auto partition : partitions) {
+        auto& ready_queue = ready_queues_[partition];
+        ready_queue.pop();
+        if (not ready_queue.empty()) {
+            schedule_head(partition);
+        }
+    }
+    pool_.release(request);
+}
+
+int Engine::submitted_requests() const {
+    return submitted_requests_;
+}
+
+}
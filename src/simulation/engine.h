@@ -0,0 +1,64 @@
+#ifndef SIMULATION_ENGINE_H
+#define SIMULATION_ENGINE_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "event_queue.h"
+#include "log/execution_log.h"
+#include "partition/partition_set.h"
+#include "ready_queue.h"
+#include "request_pool.h"
+
+namespace simulation {
+
+// How a request involving several partitions is charged once all of them
+// reached it.
+// EXECUTE_ON_LONGEST: the partition that has been running the longest
+// executes it, the others sync with it and then spend the same time on
+// the request (MinCutManager).
+// EXECUTE_ON_ALL: the partitions sync and every one of them executes the
+// request (EarlyMinCutManager).
+enum ExecutionPolicy {EXECUTE_ON_LONGEST, EXECUTE_ON_ALL};
+
+// Discrete-event core shared by the managers. Every partition has a ready
+// queue of the requests that involve it, in submission order. When a
+// partition becomes free it reaches the head of its queue, which is an
+// event timestamped with the partition's elapsed time; a request starts
+// once all its partitions reached it, and is charged to the ExecutionLog
+// according to the policy.
+class Engine {
+public:
+    Engine(
+        workload::ExecutionLog& log,
+        ExecutionPolicy policy,
+        int execution_time = 1
+    );
+
+    void submit(const workload::PartitionSet& partitions);
+    void barrier();
+    void run();
+
+    int submitted_requests() const;
+
+private:
+    void enqueue(int request);
+    void schedule_head(int partition);
+    void start(int request);
+
+    workload::ExecutionLog& log_;
+    ExecutionPolicy policy_;
+    int execution_time_;
+
+    EventQueue events_;
+    RequestPool pool_;
+    std::vector<ReadyQueue> ready_queues_;
+    long long event_counter_{0};
+    int submitted_requests_{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "event_queue.h"
+
+namespace simulation {
+
+bool EventQueue::precedes(const Event& a, const Event& b) {
+    if (a.time != b.time) {
+        return a.time < b.time;
+    }
+    return a.key < b.key;
+}
+
+void EventQueue::push(const Event& event) {
+    heap_.push_back(event);
+    auto index = heap_.size() - 1;
+    while (index > 0) {
+        auto parent = (index - 1) / ARITY;
+        if (not precedes(heap_[index], heap_[parent])) {
+            break;
+        }
+        std::swap(heap_[index], heap_[parent]);
+        index = parent;
+    }
+}
+
+Event EventQueue::pop() {
+    auto event = heap_.front();
+    heap_.front() = heap_.back();
+    heap_.pop_back();
+    if (not heap_.empty()) {
+        sift_down(0);
+    }
+    return event;
+}
+
+void EventQueue::replace_top(const Event& event) {
+    heap_.front() = event;
+    sift_down(0);
+}
+
+void EventQueue::sift_down(std::size_t index) {
+    auto event = heap_[index];
+    while (true) {
+        auto first_child = ARITY * index + 1;
+        if (first_child >= heap_.size()) {
+            break;
+        }
+        auto last_child = std::min(first_child + ARITY, heap_.size());
+        auto smallest = first_child;
+        for (auto child = first_child + 1; child < last_child; child++) {
+            if (precedes(heap_[child], heap_[smallest])) {
+                smallest = child;
+            }
+        }
+        if (not precedes(heap_[smallest], event)) {
+            break;
+        }
+        heap_[index] = heap_[smallest];
+        index = smallest;
+    }
+    heap_[index] = event;
+}
+
+const Event& EventQueue::top() const {
+    return heap_.front();
+}
+
+bool EventQueue::empty() const {
+    return heap_.empty();
+}
+
+std::size_t EventQueue::size() const {
+    return heap_.size();
+}
+
+void EventQueue::clear() {
+    heap_.clear();
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef SIMULATION_EVENT_QUEUE_H
+#define SIMULATION_EVENT_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace simulation {
+
+struct Event {
+    int time;
+    // Breaks ties between events at the same time, lowest first
+    long long key;
+    int target;
+    int request;
+};
+
+// 4-ary min-heap of events ordered by (time, key), half as deep as a binary
+// one. Its storage is kept between uses, so steady-state pushes don't
+// allocate.
+class EventQueue {
+public:
+    EventQueue() = default;
+
+    void push(const Event& event);
+    Event pop();
+    // Same as a pop followed by a push, with a single sift
+    void replace_top(const Event& event);
+    const Event& top() const;
+    bool empty() const;
+    std::size_t size() const;
+    void clear();
+
+private:
+    static constexpr std::size_t ARITY = 4;
+
+    static bool precedes(const Event& a, const Event& b);
+    void sift_down(std::size_t index);
+
+    std::vector<Event> heap_;
+};
+
+}
+
+#endif
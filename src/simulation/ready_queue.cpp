@@ -0,0 +1,35 @@
+#include "ready_queue.h"
+
+namespace simulation {
+
+void ReadyQueue::push(int request) {
+    if (size_ == buffer_.size()) {
+        auto buffer = std::vector<int>(std::max<std::size_t>(4, 2 * size_));
+        for (auto i = 0; i < size_; i++) {
+            buffer[i] = buffer_[(head_ + i) % buffer_.size()];
+        }
+        buffer_ = std::move(buffer);
+        head_ = 0;
+    }
+    buffer_[(head_ + size_) % buffer_.size()] = request;
+    size_++;
+}
+
+void ReadyQueue::pop() {
+    head_ = (head_ + 1) % buffer_.size();
+    size_--;
+}
+
+int ReadyQueue::front() const {
+    return buffer_[head_];
+}
+
+bool ReadyQueue::empty() const {
+    return size_ == 0;
+}
+
+std::size_t ReadyQueue::size() const {
+    return size_;
+}
+
+}
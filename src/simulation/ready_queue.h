@@ -0,0 +1,29 @@
+#ifndef SIMULATION_READY_QUEUE_H
+#define SIMULATION_READY_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace simulation {
+
+// FIFO of pooled request ids over a ring buffer that only grows
+class ReadyQueue {
+public:
+    ReadyQueue() = default;
+
+    void push(int request);
+    void pop();
+    int front() const;
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    std::vector<int> buffer_;
+    std::size_t head_{0};
+    std::size_t size_{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include "request_pool.h"
+
+namespace simulation {
+
+int RequestPool::acquire() {
+    if (free_requests_.empty()) {
+        requests_.emplace_back();
+        return requests_.size() - 1;
+    }
+
+    auto request = free_requests_.back();
+    free_requests_.pop_back();
+    return request;
+}
+
+void RequestPool::release(int request) {
+    requests_[request].partitions.clear();
+    free_requests_.push_back(request);
+}
+
+PooledRequest& RequestPool::at(int request) {
+    return requests_[request];
+}
+
+const PooledRequest& RequestPool::at(int request) const {
+    return requests_[request];
+}
+
+}
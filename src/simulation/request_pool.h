@@ -0,0 +1,37 @@
+#ifndef SIMULATION_REQUEST_POOL_H
+#define SIMULATION_REQUEST_POOL_H
+
+#include <vector>
+
+#include "partition/partition_set.h"
+
+namespace simulation {
+
+enum RequestKind {EXECUTE, BARRIER};
+
+struct PooledRequest {
+    RequestKind kind;
+    workload::PartitionSet partitions;
+    // Involved partitions that haven't reached this request yet
+    int pending;
+};
+
+// Recycles request objects, so a running simulation stops allocating once
+// warmed up.
+class RequestPool {
+public:
+    RequestPool() = default;
+
+    int acquire();
+    void release(int request);
+    PooledRequest& at(int request);
+    const PooledRequest& at(int request) const;
+
+private:
+    std::vector<PooledRequest> requests_;
+    std::vector<int> free_requests_;
+};
+
+}
+
+#endif
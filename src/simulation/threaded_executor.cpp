@@ -0,0 +1,161 @@
+#include "threaded_executor.h"
+
+namespace simulation {
+
+ThreadedExecutor::ThreadedExecutor(int n_workers, int request_cost /*= 0*/)
+    : n_workers_{std::max(1, n_workers)},
+      request_cost_{request_cost}
+{}
+
+void ThreadedExecutor::build_dependencies(
+    const std::vector<workload::Request>& requests
+) {
+    auto last_access = std::unordered_map<int, int>();
+    auto edges = std::vector<std::pair<int, int>>();
+    auto dependencies = std::vector<int>();
+    n_dependencies_.assign(requests.size(), 0);
+    for (auto i = 0; i < requests.size(); i++) {
+        dependencies.clear();
+        for (auto key : requests[i]) {
+            auto it = last_access.find(key);
+            if (it != last_access.end()) {
+                dependencies.push_back(it->second);
+            }
+            last_access[key] = i;
+        }
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(
+            std::unique(dependencies.begin(), dependencies.end()),
+            dependencies.end()
+        );
+        for (auto dependency : dependencies) {
+            edges.emplace_back(dependency, i);
+        }
+        n_dependencies_[i] = dependencies.size();
+    }
+
+    successor_offsets_.assign(requests.size() + 1, 0);
+    for (const auto& edge : edges) {
+        successor_offsets_[edge.first + 1]++;
+    }
+    for (auto i = 0; i < requests.size(); i++) {
+        successor_offsets_[i + 1] += successor_offsets_[i];
+    }
+    successors_.resize(edges.size());
+    auto next = std::vector<int>(
+        successor_offsets_.begin(), successor_offsets_.end() - 1
+    );
+    for (const auto& edge : edges) {
+        successors_[next[edge.first]++] = edge.second;
+    }
+}
+
+long long percentile(const std::vector<long long>& sorted_values, int percent) {
+    if (sorted_values.empty()) {
+        return 0;
+    }
+    return sorted_values[(sorted_values.size() - 1) * percent / 100];
+}
+
+workload::ExecutorStats ThreadedExecutor::run(
+    const std::vector<workload::Request>& requests
+) {
+    build_dependencies(requests);
+    const auto n_requests = (long long) requests.size();
+
+    auto pending = std::vector<std::atomic<int>>(n_requests);
+    for (auto i = 0; i < n_requests; i++) {
+        pending[i].store(n_dependencies_[i], std::memory_order_relaxed);
+    }
+    auto ready_at = std::vector<long long>(n_requests, 0);
+    auto ready_queue = ConcurrentReadyQueue(n_requests);
+    auto executed_requests = std::atomic<long long>(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start]() -> long long {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    };
+
+    struct WorkerStats {
+        std::vector<long long> latencies;
+        long long push_retries = 0;
+        long long pop_retries = 0;
+        long long empty_polls = 0;
+    };
+    auto worker_stats = std::vector<WorkerStats>(n_workers_);
+
+    // ready_at is written before the push and read after the pop, the
+    // queue's release/acquire on the cell orders the two
+    auto make_ready = [&](int request, WorkerStats& stats) {
+        ready_at[request] = elapsed();
+        ready_queue.push(request, stats.push_retries);
+    };
+    for (auto i = 0; i < n_requests; i++) {
+        if (n_dependencies_[i] == 0) {
+            make_ready(i, worker_stats[0]);
+        }
+    }
+
+    auto work = [&](int worker) {
+        auto& stats = worker_stats[worker];
+        auto request = 0;
+        while (executed_requests.load(std::memory_order_acquire) < n_requests) {
+            if (not ready_queue.pop(request, stats.pop_retries)) {
+                stats.empty_polls++;
+                std::this_thread::yield();
+                continue;
+            }
+            stats.latencies.push_back(elapsed() - ready_at[request]);
+
+            if (request_cost_ > 0) {
+                auto until = elapsed() + request_cost_;
+                while (elapsed() < until) {}
+            }
+
+            auto begin = successor_offsets_[request];
+            auto end = successor_offsets_[request + 1];
+            for (auto i = begin; i < end; i++) {
+                auto successor = successors_[i];
+                if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    make_ready(successor, stats);
+                }
+            }
+            executed_requests.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    auto workers = std::vector<std::thread>();
+    for (auto i = 1; i < n_workers_; i++) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto stats = workload::ExecutorStats();
+    stats.n_workers = n_workers_;
+    stats.executed_requests = executed_requests.load();
+    stats.seconds = elapsed() / 1e9;
+    stats.throughput = stats.seconds > 0 ? stats.executed_requests / stats.seconds : 0;
+
+    auto latencies = std::vector<long long>();
+    for (const auto& worker : worker_stats) {
+        latencies.insert(
+            latencies.end(), worker.latencies.begin(), worker.latencies.end()
+        );
+        stats.push_retries += worker.push_retries;
+        stats.pop_retries += worker.pop_retries;
+        stats.empty_polls += worker.empty_polls;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    stats.latency_p50 = percentile(latencies, 50);
+    stats.latency_p90 = percentile(latencies, 90);
+    stats.latency_p99 = percentile(latencies, 99);
+    stats.latency_max = latencies.empty() ? 0 : latencies.back();
+    return stats;
+}
+
+}
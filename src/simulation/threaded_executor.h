@@ -0,0 +1,43 @@
+#ifndef SIMULATION_THREADED_EXECUTOR_H
+#define SIMULATION_THREADED_EXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrent_ready_queue.h"
+#include "log/execution_log.h"
+#include "request/request.h"
+
+namespace simulation {
+
+// Runs the CBase dependency DAG of a trace on real worker threads, to
+// measure what the scheduling itself costs. A request depends on the last
+// earlier request that accessed any of its keys, becomes ready once they
+// all finished and then busy-waits request_cost nanoseconds on the worker
+// that popped it from a shared lock-free ready queue.
+class ThreadedExecutor {
+public:
+    ThreadedExecutor(int n_workers, int request_cost = 0);
+
+    workload::ExecutorStats run(const std::vector<workload::Request>& requests);
+
+private:
+    void build_dependencies(const std::vector<workload::Request>& requests);
+
+    int n_workers_;
+    int request_cost_;
+
+    // Successors of request i are successors_[successor_offsets_[i] ..
+    // successor_offsets_[i+1])
+    std::vector<int> successor_offsets_;
+    std::vector<int> successors_;
+    std::vector<int> n_dependencies_;
+};
+
+}
+
+#endif
@@ -79,7 +79,8 @@ void write_cut_info(
 
 void write_log_info(
     const workload::ExecutionLog& execution_log,
-    std::ostream& output_stream
+    std::ostream& output_stream,
+    bool compress_busy_threads /*= false*/
 ) {
     write_makespan(execution_log, output_stream);
     write_requests_executed_per_partition(execution_log, output_stream);
@@ -90,14 +91,32 @@ void write_log_info(
     write_idle_time(execution_log, output_stream);
     write_syncronization_info(execution_log, output_stream);
     output_stream << "\n";
-    if (not execution_log.cut_values().empty()) {
+    if (not execution_log.cut_values().empty() or
+        not execution_log.connectivity_values().empty()
+    ) {
         write_cut_info(execution_log, output_stream);
         output_stream << "\n";
     }
-    write_busy_threads_per_time(execution_log, output_stream);
+    if (execution_log.executor_stats().n_workers != 0) {
+        write_executor_stats(execution_log, output_stream);
+        output_stream << "\n";
+    }
+    write_busy_threads_per_time(
+        execution_log, output_stream, compress_busy_threads
+    );
     output_stream << "\n";
 }
 
+void write_log_summary(
+    const workload::ExecutionLog& execution_log,
+    std::ostream& output_stream
+) {
+    output_stream << execution_log.makespan() << ","
+                  << execution_log.idle_time() << ","
+                  << execution_log.n_syncs() << ","
+                  << execution_log.processed_requests() << "\n";
+}
+
 void write_makespan(
     const workload::ExecutionLog& execution_log,
     std::ostream& output_stream
@@ -152,39 +171,48 @@ void write_syncronization_info(
 ) {
     output_stream << "Required syncs: " << execution_log.n_syncs() << "\n";
     output_stream << "Crossborder requests executed:\n";
-    auto& crossborder_requests = execution_log.crossborder_requests();
-    for (auto i = 1; i <= crossborder_requests.size(); i++) {
+    const auto& crossborder_requests = execution_log.crossborder_requests();
+    for (auto i = 1; i < crossborder_requests.size(); i++) {
         output_stream << i << " partitions: ";
-        output_stream << crossborder_requests.at(i) << "\n";
+        output_stream << crossborder_requests[i] << "\n";
     }
 }
 
-void write_busy_threads_per_time(
+void write_executor_stats(
     const workload::ExecutionLog& execution_log,
     std::ostream& output_stream
 ) {
-    // Get status
-    auto threads_status_per_time =
-        execution_log.threads_execution_status_per_time();
+    const auto& stats = execution_log.executor_stats();
+    output_stream << "Real execution on " << stats.n_workers << " threads: ";
+    output_stream << stats.executed_requests << " requests in ";
+    output_stream << stats.seconds << " s\n";
+    output_stream << "Throughput: " << stats.throughput << " requests/s\n";
+    output_stream << "Scheduler latency (ns): p50 " << stats.latency_p50;
+    output_stream << " | p90 " << stats.latency_p90;
+    output_stream << " | p99 " << stats.latency_p99;
+    output_stream << " | max " << stats.latency_max << "\n";
+    output_stream << "Ready queue contention: ";
+    output_stream << stats.push_retries << " push retries, ";
+    output_stream << stats.pop_retries << " pop retries, ";
+    output_stream << stats.empty_polls << " empty polls\n";
+}
 
-    // Fill threads that stayed idle until makespan
-    auto makespan = execution_log.makespan();
-    for (auto& thread_status_per_time: threads_status_per_time) {
-        while (thread_status_per_time.size() < makespan) {
-            thread_status_per_time.push_back('\0');
+void write_busy_threads_per_time(
+    const workload::ExecutionLog& execution_log,
+    std::ostream& output_stream,
+    bool compressed /*= false*/
+) {
+    output_stream << "Busy threads per time: ";
+    for (const auto& period: execution_log.busy_threads_per_time()) {
+        if (compressed) {
+            output_stream << period.begin << "-" << period.end << ":";
+            output_stream << period.busy_threads << " ";
+            continue;
         }
-    }
 
-    // Calculate how many threads where actually working and write it
-    output_stream << "Busy threads per time: ";
-    for (auto i = 0; i < makespan; i++) {
-        auto busy_threads = 0;
-        for (auto& thread_status_per_time: threads_status_per_time) {
-            if (thread_status_per_time.at(i) == '1') {
-                busy_threads++;
-            }
+        for (auto i = period.begin; i < period.end; i++) {
+            output_stream << period.busy_threads << " ";
         }
-        output_stream << busy_threads << " ";
     }
     output_stream << "\n";
 }
@@ -205,34 +233,62 @@ void write_cut_info(
     const workload::ExecutionLog& execution_log,
     std::ostream& output_stream
 ) {
-    output_stream << "Cut values: ";
-    for (auto cut_value: execution_log.cut_values()) {
-        output_stream << cut_value << " ";
+    if (not execution_log.cut_values().empty()) {
+        output_stream << "Cut values: ";
+        for (auto cut_value: execution_log.cut_values()) {
+            output_stream << cut_value << " ";
+        }
+        output_stream << "\n";
+    }
+
+    if (not execution_log.connectivity_values().empty()) {
+        output_stream << "Connectivity - 1 values: ";
+        for (auto connectivity_value: execution_log.connectivity_values()) {
+            output_stream << connectivity_value << " ";
+        }
+        output_stream << "\n";
     }
-    output_stream << "\n";
 
     output_stream << "Unbalance values: ";
     for (auto unbalance_value: execution_log.unbalance_values()) {
         output_stream << unbalance_value << " ";
     }
     output_stream << "\n";
+
+    if (not execution_log.repartition_lags().empty()) {
+        output_stream << "Repartition lags: ";
+        for (auto lag: execution_log.repartition_lags()) {
+            output_stream << lag << " ";
+        }
+        output_stream << "\n";
+    }
+
+    if (execution_log.discarded_repartitions() != 0) {
+        output_stream << "Discarded repartitions: ";
+        output_stream << execution_log.discarded_repartitions() << "\n";
+    }
+
+    if (not execution_log.migrated_values().empty()) {
+        output_stream << "Migrated values: ";
+        for (auto migrated_values: execution_log.migrated_values()) {
+            output_stream << migrated_values << " ";
+        }
+        output_stream << "\n";
+    }
 }
 
 void write_spanning_tree(
     const model::SpanningTree& tree,
     std::ostream& output_stream
 ) {
-    for (auto& kv : tree.ids_in_nodes()) {
-        auto node_id = kv.first;
-        auto& ids = kv.second;
-
+    for (auto node_id : tree.nodes()) {
         output_stream << "Supernode " << node_id << "\n";
         output_stream << "Weight: " << tree.vertice_weight(node_id) << " ";
         output_stream << "Parent: " << tree.parent(node_id) << "\n";
         output_stream << "Ids: ";
-        for (auto id : ids) {
+        tree.for_each_id_in_node(node_id, [&](int id) {
             output_stream << id << " ";
-        }
+        });
         output_stream << "\n\n";
     }
 }
@@ -31,6 +31,14 @@ void write_cut_info(
     std::ostream& output_stream
 );
 void write_log_info(
+    const workload::ExecutionLog& execution_log,
+    std::ostream& output_stream,
+    bool compress_busy_threads = false
+);
+// Totals of a log as a single CSV row, the columns of LOG_SUMMARY_HEADER
+const std::string LOG_SUMMARY_HEADER =
+    "makespan,idle_time,n_syncs,processed_requests";
+void write_log_summary(
     const workload::ExecutionLog& execution_log,
     std::ostream& output_stream
 );
@@ -73,11 +81,19 @@ void write_cut_info(
     std::ostream& output_stream
 );
 
-void write_busy_threads_per_time(
+void write_executor_stats(
     const workload::ExecutionLog& execution_log,
     std::ostream& output_stream
 );
 
+// Compressed output writes "begin-end:busy_threads" for every [begin, end)
+// period instead of one number per time unit
+void write_busy_threads_per_time(
+    const workload::ExecutionLog& execution_log,
+    std::ostream& output_stream,
+    bool compressed = false
+);
+
 }
 
 #endif